@@ -0,0 +1,124 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstring>
+
+// External
+#include <SDL2/SDL.h>
+
+// Project
+#include "./AssetPack.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+AssetPack::AssetPack(std::string const& s_FilePath) : p_Data(NULL),
+                                                      us_Size(0),
+                                                      p_Header(NULL),
+                                                      p_Entry(NULL)
+{
+    int i_FD = open(s_FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat c_Stat;
+    
+    if (i_FD < 0)
+    {
+        throw Exception("Failed to open asset pack: " + s_FilePath);
+    }
+    else if (fstat(i_FD, &c_Stat) < 0 || (size_t)c_Stat.st_size < sizeof(Header))
+    {
+        close(i_FD);
+        throw Exception("Invalid asset pack: " + s_FilePath);
+    }
+    
+    // The mapping stays valid after closing the descriptor
+    void* p_Map = mmap(NULL, (size_t)c_Stat.st_size, PROT_READ, MAP_PRIVATE, i_FD, 0);
+    close(i_FD);
+    
+    if (p_Map == MAP_FAILED)
+    {
+        throw Exception("Failed to map asset pack: " + s_FilePath);
+    }
+    
+    p_Data = (const uint8_t*)p_Map;
+    us_Size = (size_t)c_Stat.st_size;
+    p_Header = (Header const*)p_Data;
+    p_Entry = (Entry const*)(p_Data + sizeof(Header));
+    
+    // Check the header and every entry once, getters trust the index
+    bool b_Valid = (p_Header->u32_Magic == u32_Magic &&
+                    p_Header->u32_Version == u32_Version &&
+                    (us_Size - sizeof(Header)) / sizeof(Entry) >= p_Header->u32_Count);
+    
+    for (uint32_t i = 0; b_Valid == true && i < p_Header->u32_Count; ++i)
+    {
+        Entry const& c_Entry = p_Entry[i];
+        
+        b_Valid = (memchr(c_Entry.p_Name, '\0', sizeof(c_Entry.p_Name)) != NULL &&
+                   c_Entry.u64_Offset % u64_PageSize == 0 &&
+                   c_Entry.u64_Offset <= us_Size &&
+                   c_Entry.u64_Size <= us_Size - c_Entry.u64_Offset &&
+                   c_Entry.u32_Pitch >= c_Entry.u32_W * SDL_BYTESPERPIXEL(p_Header->u32_Format) &&
+                   (uint64_t)c_Entry.u32_Pitch * c_Entry.u32_H <= c_Entry.u64_Size);
+    }
+    
+    if (b_Valid == false)
+    {
+        munmap(p_Map, us_Size);
+        throw Exception("Invalid asset pack: " + s_FilePath);
+    }
+    
+    // All entries are uploaded right away
+    madvise(p_Map, us_Size, MADV_WILLNEED);
+}
+
+AssetPack::~AssetPack() noexcept
+{
+    munmap((void*)p_Data, us_Size);
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+uint32_t AssetPack::GetFormat() const noexcept
+{
+    return p_Header->u32_Format;
+}
+
+AssetPack::Entry const* AssetPack::GetEntry(const char* p_Name) const noexcept
+{
+    for (uint32_t i = 0; i < p_Header->u32_Count; ++i)
+    {
+        if (strcmp(p_Entry[i].p_Name, p_Name) == 0)
+        {
+            return &(p_Entry[i]);
+        }
+    }
+    
+    return NULL;
+}
+
+const void* AssetPack::GetPixels(Entry const& c_Entry) const noexcept
+{
+    return p_Data + c_Entry.u64_Offset;
+}
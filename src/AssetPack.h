@@ -0,0 +1,138 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef AssetPack_h
+#define AssetPack_h
+
+// C / C++
+#include <cstdint>
+#include <string>
+
+// External
+
+// Project
+#include "./Exception.h"
+
+
+class AssetPack
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    // File header, followed by the entry index
+    struct Header
+    {
+        uint32_t u32_Magic;
+        uint32_t u32_Version;
+        uint32_t u32_Format; // SDL pixel format of all entries
+        uint32_t u32_Count;
+    };
+    
+    // Index entry, pixel data starts page aligned
+    struct Entry
+    {
+        char p_Name[56];
+        uint32_t u32_W;
+        uint32_t u32_H;
+        uint32_t u32_Pitch;
+        uint32_t u32_Reserved;
+        uint64_t u64_Offset;
+        uint64_t u64_Size;
+    };
+    
+    static constexpr uint32_t u32_Magic = 0x5041524D; // "MRAP"
+    static constexpr uint32_t u32_Version = 1;
+    static constexpr uint64_t u64_PageSize = 4096;
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor. The pack file is mapped and validated.
+     *  
+     *  \param s_FilePath The pack file path.
+     */
+    
+    AssetPack(std::string const& s_FilePath);
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_AssetPack AssetPack class source.
+     */
+    
+    AssetPack(AssetPack const& c_AssetPack) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~AssetPack() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the SDL pixel format used by all entries.
+     *  
+     *  \return The SDL pixel format.
+     */
+    
+    uint32_t GetFormat() const noexcept;
+    
+    /**
+     *  Get a pack entry.
+     *  
+     *  \param p_Name The entry name.
+     *  
+     *  \return The entry, NULL if no entry exists for the name.
+     */
+    
+    Entry const* GetEntry(const char* p_Name) const noexcept;
+    
+    /**
+     *  Get the pixel data of a pack entry. The data stays mapped until the 
+     *  pack is destroyed.
+     *  
+     *  \param c_Entry The entry to get the pixels for.
+     *  
+     *  \return The entry pixel data.
+     */
+    
+    const void* GetPixels(Entry const& c_Entry) const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    const uint8_t* p_Data;
+    size_t us_Size;
+    
+    Header const* p_Header;
+    Entry const* p_Entry;
+    
+protected:
+    
+};
+
+#endif /* AssetPack_h */
@@ -0,0 +1,415 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/resource.h>
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+#include <ctime>
+#include <clocale>
+#include <chrono>
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+// External
+#include <SDL2/SDL_image.h>
+#include <SDL2/SDL_ttf.h>
+
+// Project
+#include "../UI.h"
+#include "../UIComponent/TodayInfo.h"
+#include "../Reactor.h"
+#include "../Logger.h"
+#include "../Revision.h"
+
+// Pre-defined
+namespace
+{
+    // Scenario sizes
+    constexpr size_t us_StartupRuns = 5;
+    constexpr size_t us_SteadyFrames = 1000;
+    constexpr size_t us_DayMinutes = 24 * 60;
+    constexpr size_t us_ResizeSteps = 200;
+    
+    // The ui locale if none is configured, its formats have to be drawn 
+    // from the glyph atlases
+    const char* p_DefaultLocale = "en_US.UTF-8";
+    
+    // Asset decoding has to finish within this time
+    constexpr Uint32 u32_AssetTimeoutMS = 10000;
+    
+    // Results
+    struct Scenario
+    {
+        std::string s_Name;
+        std::vector<double> v_Sample; // Microseconds
+        long l_PeakRSS; // KiB
+        size_t us_TextureBytes;
+    };
+}
+
+
+//*************************************************************************************
+// Measure
+//*************************************************************************************
+
+static double GetElapsedUS(std::chrono::steady_clock::time_point const& c_Start) noexcept
+{
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - c_Start).count();
+}
+
+static long GetPeakRSS() noexcept
+{
+    struct rusage c_Usage;
+    
+    if (getrusage(RUSAGE_SELF, &c_Usage) < 0)
+    {
+        return -1;
+    }
+    
+    return c_Usage.ru_maxrss;
+}
+
+static bool WaitForAssets() noexcept
+{
+    // The last background asset decoder requests a redraw
+    SDL_Event c_Event;
+    Uint32 u32_End = SDL_GetTicks() + u32_AssetTimeoutMS;
+    
+    while (SDL_TICKS_PASSED(SDL_GetTicks(), u32_End) == false)
+    {
+        if (SDL_WaitEventTimeout(&c_Event, 100) == 0)
+        {
+            continue;
+        }
+        
+        if (c_Event.type == Reactor::GetEventType() && c_Event.user.code == Reactor::REDRAW)
+        {
+            return true;
+        }
+    }
+    
+    return false;
+}
+
+static time_t GetDayStart() noexcept
+{
+    // Use a fixed day so that runs are comparable
+    struct tm c_Day;
+    memset(&c_Day, 0, sizeof(c_Day));
+    
+    c_Day.tm_year = 2022 - 1900;
+    c_Day.tm_mon = 0;
+    c_Day.tm_mday = 1;
+    c_Day.tm_isdst = -1;
+    
+    return mktime(&c_Day);
+}
+
+//*************************************************************************************
+// Scenarios
+//*************************************************************************************
+
+static void RunStartup(Scenario& c_Scenario, int i_W, int i_H)
+{
+    Clock c_Clock;
+    c_Clock.Update(GetDayStart());
+    
+    for (size_t i = 0; i < us_StartupRuns; ++i)
+    {
+        // Construction until the first frame with all assets
+        auto c_Start = std::chrono::steady_clock::now();
+        
+        UI c_UI(i_W, i_H, true, false, 0, "", "");
+        c_UI.Initialize();
+        
+        if (WaitForAssets() == false)
+        {
+            throw Exception("Timed out waiting for assets!");
+        }
+        
+        c_UI.Draw(c_Clock);
+        
+        c_Scenario.v_Sample.emplace_back(GetElapsedUS(c_Start));
+        c_Scenario.us_TextureBytes = c_UI.GetTextureBytes();
+    }
+}
+
+static void RunSteady(Scenario& c_Scenario, UI& c_UI, Clock& c_Clock)
+{
+    // Every frame is a minute change, an unchanged clock draws nothing
+    time_t us_Start = GetDayStart() + (12 * 60 * 60);
+    
+    for (size_t i = 0; i < us_SteadyFrames; ++i)
+    {
+        c_Clock.Update(us_Start + (time_t)(i * 60));
+        
+        auto c_Start = std::chrono::steady_clock::now();
+        c_UI.Draw(c_Clock);
+        c_Scenario.v_Sample.emplace_back(GetElapsedUS(c_Start));
+    }
+    
+    c_Scenario.us_TextureBytes = c_UI.GetTextureBytes();
+}
+
+static void RunDay(Scenario& c_Scenario, UI& c_UI, Clock& c_Clock)
+{
+    time_t us_Start = GetDayStart();
+    size_t us_Fallback = TodayInfo::GetFallbackCount();
+    
+    for (size_t i = 0; i < us_DayMinutes; ++i)
+    {
+        c_Clock.Update(us_Start + (time_t)(i * 60));
+        
+        auto c_Start = std::chrono::steady_clock::now();
+        c_UI.Draw(c_Clock);
+        c_Scenario.v_Sample.emplace_back(GetElapsedUS(c_Start));
+    }
+    
+    c_Scenario.us_TextureBytes = c_UI.GetTextureBytes();
+    
+    // Every minute of the day has to come from the atlases
+    if (TodayInfo::GetFallbackCount() != us_Fallback)
+    {
+        throw Exception("Glyph atlas fallback taken " + 
+                        std::to_string(TodayInfo::GetFallbackCount() - us_Fallback) + 
+                        " times in a day!");
+    }
+}
+
+static void RunResize(Scenario& c_Scenario, UI& c_UI, Clock const& c_Clock, int i_W, int i_H)
+{
+    // Cycle through sizes up to the start size, the headless surface 
+    // is kept like a frame texture that still fits
+    const int p_Scale[] = { 100, 50, 75, 90, 60 };
+    constexpr size_t us_ScaleCount = sizeof(p_Scale) / sizeof(int);
+    
+    for (size_t i = 0; i < us_ResizeSteps; ++i)
+    {
+        int i_Scale = p_Scale[i % us_ScaleCount];
+        
+        auto c_Start = std::chrono::steady_clock::now();
+        c_UI.UpdateSize((i_W * i_Scale) / 100, (i_H * i_Scale) / 100);
+        c_UI.Draw(c_Clock);
+        c_Scenario.v_Sample.emplace_back(GetElapsedUS(c_Start));
+    }
+    
+    c_UI.UpdateSize(i_W, i_H);
+    c_Scenario.us_TextureBytes = c_UI.GetTextureBytes();
+}
+
+//*************************************************************************************
+// Report
+//*************************************************************************************
+
+static double GetPercentile(std::vector<double> const& v_Sorted, double f64_Percentile) noexcept
+{
+    if (v_Sorted.size() == 0)
+    {
+        return 0.0;
+    }
+    
+    // Nearest rank
+    size_t us_Rank = (size_t)((f64_Percentile / 100.0) * v_Sorted.size() + 0.5);
+    
+    if (us_Rank == 0)
+    {
+        us_Rank = 1;
+    }
+    else if (us_Rank > v_Sorted.size())
+    {
+        us_Rank = v_Sorted.size();
+    }
+    
+    return v_Sorted[us_Rank - 1];
+}
+
+static std::string CreateReport(std::vector<Scenario> const& v_Scenario, int i_W, int i_H)
+{
+    std::ostringstream s_Report;
+    
+    s_Report << "{\n"
+             << "  \"version\": \"" << VERSION_NUMBER << "\",\n"
+             << "  \"width\": " << i_W << ",\n"
+             << "  \"height\": " << i_H << ",\n"
+             << "  \"scenarios\": [\n";
+    
+    for (size_t i = 0; i < v_Scenario.size(); ++i)
+    {
+        Scenario const& c_Scenario = v_Scenario[i];
+        std::vector<double> v_Sorted = c_Scenario.v_Sample;
+        double f64_Sum = 0.0;
+        
+        std::sort(v_Sorted.begin(), v_Sorted.end());
+        
+        for (double f64_Sample : v_Sorted)
+        {
+            f64_Sum += f64_Sample;
+        }
+        
+        s_Report << "    {\n"
+                 << "      \"name\": \"" << c_Scenario.s_Name << "\",\n"
+                 << "      \"samples\": " << v_Sorted.size() << ",\n"
+                 << "      \"mean_us\": " << (v_Sorted.size() > 0 ? f64_Sum / v_Sorted.size() : 0.0) << ",\n"
+                 << "      \"p50_us\": " << GetPercentile(v_Sorted, 50.0) << ",\n"
+                 << "      \"p90_us\": " << GetPercentile(v_Sorted, 90.0) << ",\n"
+                 << "      \"p99_us\": " << GetPercentile(v_Sorted, 99.0) << ",\n"
+                 << "      \"max_us\": " << (v_Sorted.size() > 0 ? v_Sorted.back() : 0.0) << ",\n"
+                 << "      \"peak_rss_kib\": " << c_Scenario.l_PeakRSS << ",\n"
+                 << "      \"texture_bytes\": " << c_Scenario.us_TextureBytes << "\n"
+                 << "    }" << (i + 1 < v_Scenario.size() ? "," : "") << "\n";
+    }
+    
+    s_Report << "  ]\n"
+             << "}\n";
+    
+    return s_Report.str();
+}
+
+//*************************************************************************************
+// Main
+//*************************************************************************************
+
+int main(int argc, char* argv[])
+{
+    std::string s_Output = "";
+    int i_W = 1920;
+    int i_H = 1080;
+    
+    // Read arguments
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], "--output") == 0 && i + 1 < argc)
+        {
+            s_Output = argv[++i];
+        }
+        else if (strcmp(argv[i], "--size") == 0 && i + 1 < argc)
+        {
+            if (sscanf(argv[++i], "%dx%d", &i_W, &i_H) != 2 || i_W <= 0 || i_H <= 0)
+            {
+                std::cerr << "Invalid size: " << argv[i] << std::endl;
+                return EXIT_FAILURE;
+            }
+        }
+        else
+        {
+            std::cerr << "Usage: " << argv[0] << " [--size <W>x<H>] [--output <file>]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+    
+    // Initialize SDL, rendering is done to a software surface
+    if (SDL_Init(SDL_INIT_EVENTS | SDL_INIT_TIMER) < 0 || IMG_Init(IMG_INIT_PNG) < 0 || TTF_Init() < 0)
+    {
+        std::cerr << "Failed to initialize SDL!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    // Format like the ui does without a locale file
+    locale_t c_Locale = newlocale(LC_ALL_MASK, p_DefaultLocale, (locale_t)0);
+    
+    if (c_Locale == (locale_t)0)
+    {
+        std::cerr << "Locale " << p_DefaultLocale << " is missing, using C!" << std::endl;
+    }
+    else
+    {
+        uselocale(c_Locale);
+    }
+    
+    std::vector<Scenario> v_Scenario;
+    int i_Result = EXIT_SUCCESS;
+    
+    try
+    {
+        // Startup runs first, everything else uses the same loaded ui
+        v_Scenario.push_back({ "startup", {}, 0, 0 });
+        RunStartup(v_Scenario.back(), i_W, i_H);
+        v_Scenario.back().l_PeakRSS = GetPeakRSS();
+        
+        UI c_UI(i_W, i_H, true, false, 0, "", "");
+        Clock c_Clock;
+        
+        c_UI.Initialize();
+        
+        if (WaitForAssets() == false)
+        {
+            throw Exception("Timed out waiting for assets!");
+        }
+        
+        c_Clock.Update(GetDayStart());
+        c_UI.Draw(c_Clock);
+        
+        v_Scenario.push_back({ "steady", {}, 0, 0 });
+        RunSteady(v_Scenario.back(), c_UI, c_Clock);
+        v_Scenario.back().l_PeakRSS = GetPeakRSS();
+        
+        v_Scenario.push_back({ "day", {}, 0, 0 });
+        RunDay(v_Scenario.back(), c_UI, c_Clock);
+        v_Scenario.back().l_PeakRSS = GetPeakRSS();
+        
+        v_Scenario.push_back({ "resize", {}, 0, 0 });
+        RunResize(v_Scenario.back(), c_UI, c_Clock, i_W, i_H);
+        v_Scenario.back().l_PeakRSS = GetPeakRSS();
+    }
+    catch (std::exception& e)
+    {
+        MRANGEUI_LOG_ERROR("{}", e.what());
+        std::cerr << "Benchmark failed: " << e.what() << std::endl;
+        i_Result = EXIT_FAILURE;
+    }
+    
+    TTF_Quit();
+    IMG_Quit();
+    SDL_Quit();
+    
+    if (c_Locale != (locale_t)0)
+    {
+        uselocale(LC_GLOBAL_LOCALE);
+        freelocale(c_Locale);
+    }
+    
+    if (i_Result != EXIT_SUCCESS)
+    {
+        return i_Result;
+    }
+    
+    // Write report
+    std::string s_Report = CreateReport(v_Scenario, i_W, i_H);
+    
+    if (s_Output.size() == 0)
+    {
+        std::cout << s_Report;
+    }
+    else
+    {
+        std::ofstream f_Output(s_Output, std::ios::out | std::ios::trunc);
+        
+        if (f_Output.is_open() == false)
+        {
+            std::cerr << "Failed to open output file: " << s_Output << std::endl;
+            return EXIT_FAILURE;
+        }
+        
+        f_Output << s_Report;
+    }
+    
+    return EXIT_SUCCESS;
+}
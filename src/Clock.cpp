@@ -16,6 +16,8 @@
 
 // C / C++
 #include <time.h>
+#include <cstdlib>
+#include <cstring>
 
 // External
 
@@ -27,13 +29,40 @@
 // Constructor / Destructor
 //*************************************************************************************
 
-Clock::Clock() noexcept : i_Minutes(0),
-                          i_Hours(0),
-                          i_Day(0),
-                          i_Month(0),
-                          i_Year(0)
+Clock::Clock() noexcept : Clock(NULL)
 {}
 
+Clock::Clock(TimeSource const& c_TimeSource) noexcept : Clock(&c_TimeSource)
+{}
+
+Clock::Clock(TimeSource const* p_TimeSource) noexcept : p_TimeSource(p_TimeSource),
+                                                        i_Minutes(0),
+                                                        i_Hours(0),
+                                                        i_Day(0),
+                                                        i_Month(0),
+                                                        i_Year(0),
+                                                        f32_MinuteOffset(0.f),
+                                                        u32_Generation(0),
+                                                        c_Format(),
+                                                        us_MinuteStart(0),
+                                                        us_MinuteEnd(0),
+                                                        b_TimeZone(false),
+                                                        s_TimeZone("")
+{
+    const char* p_TimeZone = getenv("TZ");
+    
+    memset(&c_LocalTime, 0, sizeof(c_LocalTime));
+    
+    if (p_TimeZone != NULL)
+    {
+        b_TimeZone = true;
+        s_TimeZone = p_TimeZone;
+    }
+    
+    // localtime_r() does not load the time zone on its own
+    tzset();
+}
+
 Clock::~Clock() noexcept
 {}
 
@@ -47,8 +76,50 @@ int i_TDay = 1;
 
 void Clock::Update() noexcept
 {
-    time_t us_Time = time(NULL);
-    struct tm c_LocalTime = *localtime(&us_Time);
+    if (p_TimeSource == NULL)
+    {
+        Update(TimeSource::GetWallTime());
+        return;
+    }
+    
+    time_t us_Time = p_TimeSource->GetTime();
+    double f64_Offset = (p_TimeSource->GetPreciseTime() - (double)(us_Time - (us_Time % 60))) / 60.0;
+    
+    Update(us_Time);
+    
+    f32_MinuteOffset = (float)(f64_Offset < -1.0 ? -1.0 : (f64_Offset > 1.0 ? 1.0 : f64_Offset));
+}
+
+void Clock::Update(time_t us_Time) noexcept
+{
+    // TZ is checked here, /etc/localtime changes are reported
+    // through Invalidate()
+    const char* p_TimeZone = getenv("TZ");
+    
+    if ((p_TimeZone != NULL) != b_TimeZone ||
+        (p_TimeZone != NULL && s_TimeZone.compare(p_TimeZone) != 0))
+    {
+        b_TimeZone = (p_TimeZone != NULL);
+        s_TimeZone = (p_TimeZone != NULL ? p_TimeZone : "");
+        
+        Invalidate();
+    }
+    
+    // Formats follow the locale
+    c_Format.Update();
+    
+    f32_MinuteOffset = (float)(us_Time % 60) / 60.f;
+    
+    // Still the same minute?
+    if (us_Time >= us_MinuteStart && us_Time < us_MinuteEnd)
+    {
+        return;
+    }
+    
+    if (localtime_r(&us_Time, &c_LocalTime) == NULL)
+    {
+        return;
+    }
     
     i_Minutes = c_LocalTime.tm_min;
     i_Hours = c_LocalTime.tm_hour;
@@ -56,6 +127,22 @@ void Clock::Update() noexcept
     i_Day = c_LocalTime.tm_mday;
     i_Month = c_LocalTime.tm_mon + 1;
     i_Year = c_LocalTime.tm_year + 1900;
+    
+    // A time zone change can keep the minute, users compare this instead
+    ++u32_Generation;
+    
+    // Time zone offsets are full minutes, the local minute 
+    // changes with the next full minute of the given time
+    us_MinuteStart = us_Time - (us_Time % 60);
+    us_MinuteEnd = us_MinuteStart + 60;
+}
+
+void Clock::Invalidate() noexcept
+{
+    tzset();
+    
+    us_MinuteStart = 0;
+    us_MinuteEnd = 0;
 }
 
 //*************************************************************************************
@@ -87,47 +174,27 @@ int Clock::GetYear() const noexcept
     return i_Year;
 }
 
-std::string Clock::GetTimeString() const noexcept
+float Clock::GetMinuteOffset() const noexcept
 {
-    std::string s_Time = std::to_string(i_Hours);
-    
-    if (i_Hours < 10)
-    {
-        s_Time.insert(0, "0");
-    }
-    
-    s_Time += ":";
-    
-    if (i_Minutes < 10)
-    {
-        s_Time += "0";
-    }
-    
-    s_Time += std::to_string(i_Minutes);
-    
-    return s_Time;
+    return f32_MinuteOffset;
 }
 
-std::string Clock::GetDateString() const noexcept
+uint32_t Clock::GetGeneration() const noexcept
 {
-    std::string s_Date = std::to_string(i_Day);
-    
-    if (i_Day < 10)
-    {
-        s_Date.insert(0, "0");
-    }
-    
-    s_Date += ".";
-    
-    if (i_Month < 10)
-    {
-        s_Date += "0";
-    }
-    
-    s_Date += std::to_string(i_Month);
-    s_Date += ".";
-    
-    s_Date += std::to_string(i_Year);
-    
-    return s_Date;
+    return u32_Generation;
+}
+
+size_t Clock::GetTimeString(char* p_Buffer, size_t us_Size) const noexcept
+{
+    return c_Format.Format(p_Buffer, us_Size, TimeFormat::TIME, c_LocalTime);
+}
+
+size_t Clock::GetDateString(char* p_Buffer, size_t us_Size) const noexcept
+{
+    return c_Format.Format(p_Buffer, us_Size, TimeFormat::DATE, c_LocalTime);
+}
+
+TimeFormat const& Clock::GetFormat() const noexcept
+{
+    return c_Format;
 }
@@ -19,10 +19,14 @@
 
 // C / C++
 #include <string>
+#include <ctime>
+#include <cstdint>
 
 // External
 
 // Project
+#include "./TimeSource.h"
+#include "./TimeFormat.h"
 
 
 class Clock
@@ -34,11 +38,20 @@ public:
     //*************************************************************************************
     
     /**
-     *  Default constructor.
+     *  Default constructor. The clock uses the wall clock.
      */
     
     Clock() noexcept;
     
+    /**
+     *  Time source constructor.
+     *  
+     *  \param c_TimeSource The time source to update from. The time source 
+     *                      has to outlive the clock.
+     */
+    
+    Clock(TimeSource const& c_TimeSource) noexcept;
+    
     /**
      *  Copy constructor. Disabled for this class.
      *
@@ -58,11 +71,27 @@ public:
     //*************************************************************************************
     
     /**
-     *  Update the clock.
+     *  Update the clock from the time source. The local time is only 
+     *  recalculated once the cached minute has passed.
      */
     
     void Update() noexcept;
     
+    /**
+     *  Update the clock to a given time.
+     *  
+     *  \param us_Time The time to use.
+     */
+    
+    void Update(time_t us_Time) noexcept;
+    
+    /**
+     *  Reload the time zone and recalculate the local time on the next 
+     *  update.
+     */
+    
+    void Invalidate() noexcept;
+    
     //*************************************************************************************
     // Getters
     //*************************************************************************************
@@ -108,27 +137,76 @@ public:
     int GetYear() const noexcept;
     
     /**
-     *  Get the time string.
+     *  Get the time passed since the start of the current minute. Values 
+     *  slightly below 0 are possible if the time source rounded up to the 
+     *  current minute.
      *  
-     *  \return The time string.
+     *  \return The passed time in minutes, between -1 and 1.
      */
     
-    std::string GetTimeString() const noexcept;
+    float GetMinuteOffset() const noexcept;
     
     /**
-     *  Get the date string.
+     *  Get the local time generation. The generation changes whenever the 
+     *  local time is calculated again, for a new minute or after the time 
+     *  zone changed.
      *  
-     *  \return The date string.
+     *  \return The local time generation.
      */
     
-    std::string GetDateString() const noexcept;
+    uint32_t GetGeneration() const noexcept;
+    
+    /**
+     *  Get the time string in the locale time format. No memory is allocated.
+     *  
+     *  \param p_Buffer The buffer to write the terminated string to.
+     *  \param us_Size The buffer size.
+     *  
+     *  \return The string length, 0 if the buffer was too small.
+     */
+    
+    size_t GetTimeString(char* p_Buffer, size_t us_Size) const noexcept;
+    
+    /**
+     *  Get the date string in the locale date format. No memory is allocated.
+     *  
+     *  \param p_Buffer The buffer to write the terminated string to.
+     *  \param us_Size The buffer size.
+     *  
+     *  \return The string length, 0 if the buffer was too small.
+     */
+    
+    size_t GetDateString(char* p_Buffer, size_t us_Size) const noexcept;
+    
+    /**
+     *  Get the time format used for the time and date strings.
+     *  
+     *  \return The time format.
+     */
+    
+    TimeFormat const& GetFormat() const noexcept;
     
 private:
     
+    //*************************************************************************************
+    // Constructor
+    //*************************************************************************************
+    
+    /**
+     *  Shared constructor.
+     *  
+     *  \param p_TimeSource The time source to update from, NULL for the wall 
+     *                      clock.
+     */
+    
+    Clock(TimeSource const* p_TimeSource) noexcept;
+    
     //*************************************************************************************
     // Data
     //*************************************************************************************
     
+    TimeSource const* p_TimeSource;
+    
     int i_Minutes;
     int i_Hours;
     
@@ -136,6 +214,21 @@ private:
     int i_Month;
     int i_Year;
     
+    float f32_MinuteOffset;
+    
+    uint32_t u32_Generation;
+    
+    struct tm c_LocalTime;
+    TimeFormat c_Format;
+    
+    // Cached minute, [start, end)
+    time_t us_MinuteStart;
+    time_t us_MinuteEnd;
+    
+    // TZ the cache was created with
+    bool b_TimeZone;
+    std::string s_TimeZone;
+    
 protected:
     
 };
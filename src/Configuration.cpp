@@ -0,0 +1,304 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstring>
+#include <cstdio>
+
+// External
+
+// Project
+#include "./Configuration.h"
+
+// Pre-defined
+namespace
+{
+    enum Argument
+    {
+        ARG_HEADLESS = 0,
+        ARG_FRAMES = 1,
+        ARG_SIZE = 2,
+        ARG_TIME_FIXED = 3,
+        ARG_TIME_LAPSE = 4,
+        ARG_TIME_START = 5,
+        ARG_LOG_LEVEL = 6,
+        ARG_VSYNC = 7,
+        ARG_FPS = 8,
+        ARG_PACING = 9,
+        ARG_SOLAR_RATE = 10,
+        
+        ARGUMENT_MAX = ARG_SOLAR_RATE,
+        
+        ARGUMENT_COUNT = ARGUMENT_MAX + 1
+    };
+    
+    const char* p_Argument[ARGUMENT_COUNT] =
+    {
+        "--headless",
+        "--frames",
+        "--size",
+        "--time-fixed",
+        "--time-lapse",
+        "--time-start",
+        "--log-level",
+        "--vsync",
+        "--fps",
+        "--pacing",
+        "--solar-rate"
+    };
+    
+    // A full day per second, faster rates skip minutes between frames
+    constexpr int i_TimeLapseMax = 24 * 60;
+    
+    const char* p_LogLevel[Logger::LOG_LEVEL_COUNT] =
+    {
+        "info",
+        "warning",
+        "error"
+    };
+    
+    const char* p_Pacing[FramePacer::MODE_COUNT] =
+    {
+        "update",
+        "continuous"
+    };
+    
+    int GetMinuteOfDay(const char* p_Time)
+    {
+        int i_Hour;
+        int i_Minute;
+        char c_Separator = '\0';
+        
+        if (sscanf(p_Time, "%d%c%d", &i_Hour, &c_Separator, &i_Minute) != 3 ||
+            c_Separator != ':' ||
+            i_Hour < 0 || i_Hour > 23 ||
+            i_Minute < 0 || i_Minute > 59)
+        {
+            throw Exception("Invalid time: " + std::string(p_Time));
+        }
+        
+        return (i_Hour * 60) + i_Minute;
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Configuration::Configuration(int argc, char* argv[]) : i_Width(1920),
+                                                       i_Height(1080),
+                                                       b_Headless(false),
+                                                       s_FrameDirectory(""),
+                                                       e_TimeMode(TimeSource::WALL),
+                                                       i_TimeStart(-1),
+                                                       i_TimeLapse(1),
+                                                       e_LogLevel(Logger::INFO),
+                                                       b_VSync(true),
+                                                       i_FrameRate(0),
+                                                       e_Pacing(FramePacer::UPDATE),
+                                                       i_SolarRate(0)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        if (strcmp(argv[i], p_Argument[ARG_HEADLESS]) == 0)
+        {
+            b_Headless = true;
+            continue;
+        }
+        
+        // All other arguments take a value
+        if (i + 1 >= argc)
+        {
+            throw Exception("Missing value for argument: " + std::string(argv[i]));
+        }
+        
+        if (strcmp(argv[i], p_Argument[ARG_FRAMES]) == 0)
+        {
+            s_FrameDirectory = argv[++i];
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_SIZE]) == 0)
+        {
+            char c_Separator = '\0';
+            
+            if (sscanf(argv[++i], "%d%c%d", &i_Width, &c_Separator, &i_Height) != 3 ||
+                c_Separator != 'x' ||
+                i_Width <= 0 ||
+                i_Height <= 0)
+            {
+                throw Exception("Invalid size: " + std::string(argv[i]));
+            }
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_TIME_FIXED]) == 0)
+        {
+            e_TimeMode = TimeSource::FIXED;
+            i_TimeStart = GetMinuteOfDay(argv[++i]);
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_TIME_LAPSE]) == 0)
+        {
+            e_TimeMode = TimeSource::TIME_LAPSE;
+            
+            if (sscanf(argv[++i], "%d", &i_TimeLapse) != 1 || 
+                i_TimeLapse <= 0 ||
+                i_TimeLapse > i_TimeLapseMax)
+            {
+                throw Exception("Invalid time-lapse speed: " + std::string(argv[i]));
+            }
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_TIME_START]) == 0)
+        {
+            i_TimeStart = GetMinuteOfDay(argv[++i]);
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_LOG_LEVEL]) == 0)
+        {
+            int i_Level = 0;
+            
+            ++i;
+            
+            while (i_Level < Logger::LOG_LEVEL_COUNT && strcmp(argv[i], p_LogLevel[i_Level]) != 0)
+            {
+                ++i_Level;
+            }
+            
+            if (i_Level == Logger::LOG_LEVEL_COUNT)
+            {
+                throw Exception("Invalid log level: " + std::string(argv[i]));
+            }
+            
+            e_LogLevel = (Logger::LogLevel)i_Level;
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_VSYNC]) == 0)
+        {
+            ++i;
+            
+            if (strcmp(argv[i], "on") == 0)
+            {
+                b_VSync = true;
+            }
+            else if (strcmp(argv[i], "off") == 0)
+            {
+                b_VSync = false;
+            }
+            else
+            {
+                throw Exception("Invalid vsync setting: " + std::string(argv[i]));
+            }
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_FPS]) == 0)
+        {
+            if (sscanf(argv[++i], "%d", &i_FrameRate) != 1 || i_FrameRate < 0)
+            {
+                throw Exception("Invalid frame rate: " + std::string(argv[i]));
+            }
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_PACING]) == 0)
+        {
+            int i_Pacing = 0;
+            
+            ++i;
+            
+            while (i_Pacing < FramePacer::MODE_COUNT && strcmp(argv[i], p_Pacing[i_Pacing]) != 0)
+            {
+                ++i_Pacing;
+            }
+            
+            if (i_Pacing == FramePacer::MODE_COUNT)
+            {
+                throw Exception("Invalid pacing: " + std::string(argv[i]));
+            }
+            
+            e_Pacing = (FramePacer::Mode)i_Pacing;
+        }
+        else if (strcmp(argv[i], p_Argument[ARG_SOLAR_RATE]) == 0)
+        {
+            if (sscanf(argv[++i], "%d", &i_SolarRate) != 1 || i_SolarRate < 0)
+            {
+                throw Exception("Invalid solar rate: " + std::string(argv[i]));
+            }
+        }
+        else
+        {
+            throw Exception("Unknown argument: " + std::string(argv[i]));
+        }
+    }
+}
+
+Configuration::~Configuration() noexcept
+{}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+int Configuration::GetWidth() const noexcept
+{
+    return i_Width;
+}
+
+int Configuration::GetHeight() const noexcept
+{
+    return i_Height;
+}
+
+bool Configuration::GetHeadless() const noexcept
+{
+    return b_Headless;
+}
+
+std::string const& Configuration::GetFrameDirectory() const noexcept
+{
+    return s_FrameDirectory;
+}
+
+TimeSource::Mode Configuration::GetTimeMode() const noexcept
+{
+    return e_TimeMode;
+}
+
+int Configuration::GetTimeStart() const noexcept
+{
+    return i_TimeStart;
+}
+
+int Configuration::GetTimeLapse() const noexcept
+{
+    return i_TimeLapse;
+}
+
+Logger::LogLevel Configuration::GetLogLevel() const noexcept
+{
+    return e_LogLevel;
+}
+
+bool Configuration::GetVSync() const noexcept
+{
+    return b_VSync;
+}
+
+int Configuration::GetFrameRate() const noexcept
+{
+    return i_FrameRate;
+}
+
+FramePacer::Mode Configuration::GetPacing() const noexcept
+{
+    return e_Pacing;
+}
+
+int Configuration::GetSolarRate() const noexcept
+{
+    return i_SolarRate;
+}
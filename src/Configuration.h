@@ -0,0 +1,192 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Configuration_h
+#define Configuration_h
+
+// C / C++
+#include <string>
+
+// External
+
+// Project
+#include "./TimeSource.h"
+#include "./Logger.h"
+#include "./FramePacer.h"
+#include "./Exception.h"
+
+
+class Configuration
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param argc The command line argument count.
+     *  \param argv The command line arguments.
+     */
+    
+    Configuration(int argc, char* argv[]);
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_Configuration Configuration class source.
+     */
+    
+    Configuration(Configuration const& c_Configuration) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Configuration() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the user interface width.
+     *
+     *  \return The user interface width.
+     */
+    
+    int GetWidth() const noexcept;
+    
+    /**
+     *  Get the user interface height.
+     *
+     *  \return The user interface height.
+     */
+    
+    int GetHeight() const noexcept;
+    
+    /**
+     *  Check if the user interface is rendered without a window.
+     *
+     *  \return true if headless, false if not.
+     */
+    
+    bool GetHeadless() const noexcept;
+    
+    /**
+     *  Get the directory to write headless frames to.
+     *
+     *  \return The frame directory, empty if no frames are written.
+     */
+    
+    std::string const& GetFrameDirectory() const noexcept;
+    
+    /**
+     *  Get the time source mode.
+     *  
+     *  \return The time source mode.
+     */
+    
+    TimeSource::Mode GetTimeMode() const noexcept;
+    
+    /**
+     *  Get the minute of the day the time source starts at.
+     *  
+     *  \return The start minute, -1 for the current time.
+     */
+    
+    int GetTimeStart() const noexcept;
+    
+    /**
+     *  Get the simulated minutes per real second for time-lapse, at 
+     *  most a full day.
+     *  
+     *  \return The simulated minutes per second.
+     */
+    
+    int GetTimeLapse() const noexcept;
+    
+    /**
+     *  Get the minimum log level to log.
+     *  
+     *  \return The minimum log level.
+     */
+    
+    Logger::LogLevel GetLogLevel() const noexcept;
+    
+    /**
+     *  Check if presenting waits for the display refresh.
+     *  
+     *  \return true if vsync is used, false if not.
+     */
+    
+    bool GetVSync() const noexcept;
+    
+    /**
+     *  Get the maximum frames drawn per second.
+     *  
+     *  \return The maximum frame rate, 0 for no limit.
+     */
+    
+    int GetFrameRate() const noexcept;
+    
+    /**
+     *  Get the frame pacing mode.
+     *  
+     *  \return The frame pacing mode.
+     */
+    
+    FramePacer::Mode GetPacing() const noexcept;
+    
+    /**
+     *  Get the solar body updates per second between minutes.
+     *  
+     *  \return The solar body update rate, 0 for minute updates.
+     */
+    
+    int GetSolarRate() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    int i_Width;
+    int i_Height;
+    
+    bool b_Headless;
+    std::string s_FrameDirectory;
+    
+    TimeSource::Mode e_TimeMode;
+    int i_TimeStart;
+    int i_TimeLapse;
+    
+    Logger::LogLevel e_LogLevel;
+    
+    bool b_VSync;
+    int i_FrameRate;
+    FramePacer::Mode e_Pacing;
+    
+    int i_SolarRate;
+    
+protected:
+    
+};
+
+#endif /* Configuration_h */
@@ -0,0 +1,292 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <unistd.h>
+#include <math.h>
+#include <algorithm>
+
+// External
+#include <libmrhbf.h>
+
+// Project
+#include "./DayCycle.h"
+#include "./Logger.h"
+
+// Pre-defined
+#ifndef MRANGEUI_DAY_CYCLE_FILE_PATH
+    #define MRANGEUI_DAY_CYCLE_FILE_PATH "/usr/local/etc/mrh/mrangeui/DayCycle.conf"
+#endif
+
+namespace
+{
+    enum Identifier
+    {
+        // Block Names
+        BLOCK_PHASE = 0,
+        BLOCK_SOLAR = 1,
+        
+        // Phase Key
+        KEY_PHASE_HOUR = 2,
+        KEY_PHASE_MINUTE = 3,
+        KEY_PHASE_TRANSITION = 4,
+        KEY_PHASE_RED = 5,
+        KEY_PHASE_GREEN = 6,
+        KEY_PHASE_BLUE = 7,
+        
+        // Solar Key
+        KEY_SOLAR_SUN_RISE = 8,
+        KEY_SOLAR_SUN_SET = 9,
+        
+        // Bounds
+        IDENTIFIER_MAX = KEY_SOLAR_SUN_SET,
+        
+        IDENTIFIER_COUNT = IDENTIFIER_MAX + 1
+    };
+    
+    const char* p_Identifier[IDENTIFIER_COUNT] =
+    {
+        // Block Names
+        "Phase",
+        "Solar",
+        
+        // Phase Key
+        "Hour",
+        "Minute",
+        "Transition",
+        "Red",
+        "Green",
+        "Blue",
+        
+        // Solar Key
+        "SunRise",
+        "SunSet"
+    };
+    
+    constexpr int i_MinutesPerDay = 24 * 60;
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+DayCycle::DayCycle() noexcept
+{
+    if (access(MRANGEUI_DAY_CYCLE_FILE_PATH, F_OK) != 0)
+    {
+        SetDefaultSchedule();
+    }
+    else
+    {
+        try
+        {
+            ReadSchedule();
+        }
+        catch (std::exception& e)
+        {
+            MRANGEUI_LOG_WARNING("Failed to read day cycle file: {} Using default schedule.", e.what());
+            SetDefaultSchedule();
+        }
+    }
+    
+    Build();
+}
+
+DayCycle::~DayCycle() noexcept
+{}
+
+//*************************************************************************************
+// Schedule
+//*************************************************************************************
+
+static inline Uint8 ReadColor(MRH_BlockFile::Block const& c_Block, const char* p_Key)
+{
+    return (Uint8)std::min(std::max(std::stoi(c_Block.GetValue(p_Key)), 0), 255);
+}
+
+void DayCycle::ReadSchedule()
+{
+    MRANGEUI_LOG_INFO("Reading " MRANGEUI_DAY_CYCLE_FILE_PATH " day cycle config...");
+    
+    MRH_BlockFile c_File(MRANGEUI_DAY_CYCLE_FILE_PATH);
+    
+    v_Phase.clear();
+    i_SunRise = 6;
+    i_SunSet = 20;
+    
+    for (auto& Block : c_File.l_Block)
+    {
+        if (Block.GetName().compare(p_Identifier[BLOCK_PHASE]) == 0)
+        {
+            Phase c_Phase;
+            
+            c_Phase.i_Begin = ((std::stoi(Block.GetValue(p_Identifier[KEY_PHASE_HOUR])) * 60) +
+                               std::stoi(Block.GetValue(p_Identifier[KEY_PHASE_MINUTE]))) % i_MinutesPerDay;
+            c_Phase.i_Transition = std::max(std::stoi(Block.GetValue(p_Identifier[KEY_PHASE_TRANSITION])), 0);
+            c_Phase.c_Color = { ReadColor(Block, p_Identifier[KEY_PHASE_RED]),
+                                ReadColor(Block, p_Identifier[KEY_PHASE_GREEN]),
+                                ReadColor(Block, p_Identifier[KEY_PHASE_BLUE]),
+                                255 };
+            
+            v_Phase.emplace_back(c_Phase);
+        }
+        else if (Block.GetName().compare(p_Identifier[BLOCK_SOLAR]) == 0)
+        {
+            i_SunRise = std::stoi(Block.GetValue(p_Identifier[KEY_SOLAR_SUN_RISE])) % 24;
+            i_SunSet = std::stoi(Block.GetValue(p_Identifier[KEY_SOLAR_SUN_SET])) % 24;
+        }
+    }
+    
+    if (v_Phase.empty() == true)
+    {
+        throw Exception("No day cycle phases defined!");
+    }
+    else if (i_SunRise < 0 || i_SunSet < 0 || i_SunRise >= i_SunSet)
+    {
+        throw Exception("Invalid sun rise and sun set hours!");
+    }
+    
+    std::sort(v_Phase.begin(),
+              v_Phase.end(),
+              [](Phase const& c_A, Phase const& c_B) { return c_A.i_Begin < c_B.i_Begin; });
+    
+    MRANGEUI_LOG_INFO("Read day cycle config.");
+}
+
+void DayCycle::SetDefaultSchedule() noexcept
+{
+    // Morning, Day, Evening, Night
+    v_Phase = { { 6 * 60, 60, { 247, 186, 0, 255 } },
+                { 7 * 60, 60, { 0, 161, 254, 255 } },
+                { 19 * 60, 60, { 238, 94, 73, 255 } },
+                { 20 * 60, 60, { 0, 43, 72, 255 } } };
+    
+    i_SunRise = 6;
+    i_SunSet = 20;
+}
+
+//*************************************************************************************
+// Build
+//*************************************************************************************
+
+static inline Uint8 MixColor(Uint8 u8_CurrentColor, Uint8 u8_NextColor, float f32_Percent) noexcept
+{
+    return (u8_CurrentColor * (1 - f32_Percent)) + (u8_NextColor * f32_Percent);
+}
+
+void DayCycle::Build() noexcept
+{
+    // Phases are sorted, the last phase wraps around midnight
+    size_t us_Next = 0;
+    
+    for (int i_Minute = 0; i_Minute < i_MinutesPerDay; ++i_Minute)
+    {
+        Entry& c_Entry = p_Entry[i_Minute];
+        
+        /**
+         *  Tint
+         */
+        
+        while (us_Next < v_Phase.size() && v_Phase[us_Next].i_Begin <= i_Minute)
+        {
+            ++us_Next;
+        }
+        
+        size_t us_Phase = (us_Next == 0 ? v_Phase.size() : us_Next) - 1;
+        
+        Phase const& c_Current = v_Phase[us_Phase];
+        Phase const& c_Previous = v_Phase[(us_Phase + v_Phase.size() - 1) % v_Phase.size()];
+        int i_Elapsed = (i_Minute - c_Current.i_Begin + i_MinutesPerDay) % i_MinutesPerDay;
+        
+        if (i_Elapsed < c_Current.i_Transition)
+        {
+            float f32_Percent = (float)i_Elapsed / (float)(c_Current.i_Transition);
+            
+            c_Entry.c_Tint = { MixColor(c_Previous.c_Color.r, c_Current.c_Color.r, f32_Percent),
+                               MixColor(c_Previous.c_Color.g, c_Current.c_Color.g, f32_Percent),
+                               MixColor(c_Previous.c_Color.b, c_Current.c_Color.b, f32_Percent),
+                               255 };
+        }
+        else
+        {
+            c_Entry.c_Tint = c_Current.c_Color;
+        }
+        
+        /**
+         *  Solar Body
+         */
+        
+        // The sun is shown for all hours from rise to set, the moon
+        // moves from set to the next rise
+        int i_Hour = i_Minute / 60;
+        int i_HourInterval;
+        
+        if (i_Hour >= i_SunRise && i_Hour <= i_SunSet)
+        {
+            c_Entry.e_SolarBody = SUN;
+            
+            i_HourInterval = i_SunSet - i_SunRise;
+            i_Hour -= i_SunRise;
+        }
+        else
+        {
+            c_Entry.e_SolarBody = MOON;
+            
+            i_HourInterval = (24 - i_SunSet) + i_SunRise;
+            i_Hour = (i_Hour > i_SunSet ? i_Hour - i_SunSet : i_Hour + (24 - i_SunSet));
+        }
+        
+        int i_MinutesMoved = (i_Hour * 60) + (i_Minute % 60);
+        
+        // Move along a half circle with the radius of half the width
+        // @NOTE: sin and cos work on radians, not degrees!
+        float f32_MovePercent = (float)i_MinutesMoved / ((float)i_HourInterval * 60.f);
+        double f64_Angle = (M_PI * f32_MovePercent) + ((90.f * M_PI) / 180.f);
+        
+        c_Entry.f32_SolarX = 0.5f - (float)(0.5 * sin(f64_Angle));
+        c_Entry.f32_SolarY = (float)(0.5 * cos(f64_Angle));
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+DayCycle::Entry const& DayCycle::GetEntry(int i_Hours, int i_Minutes) const noexcept
+{
+    return p_Entry[((unsigned int)((i_Hours * 60) + i_Minutes)) % i_MinutesPerDay];
+}
+
+void DayCycle::GetSolarPosition(int i_Hours, int i_Minutes, float f32_Offset, float& f32_X, float& f32_Y) const noexcept
+{
+    int i_Minute = ((i_Hours * 60) + i_Minutes) % i_MinutesPerDay;
+    int i_Next = (i_Minute + (f32_Offset < 0.f ? -1 : 1) + i_MinutesPerDay) % i_MinutesPerDay;
+    
+    Entry const& c_Entry = p_Entry[i_Minute];
+    Entry const& c_Next = p_Entry[i_Next];
+    
+    f32_X = c_Entry.f32_SolarX;
+    f32_Y = c_Entry.f32_SolarY;
+    
+    if (c_Next.e_SolarBody == c_Entry.e_SolarBody)
+    {
+        float f32_Weight = (f32_Offset < 0.f ? -f32_Offset : f32_Offset);
+        
+        f32_X += (c_Next.f32_SolarX - c_Entry.f32_SolarX) * f32_Weight;
+        f32_Y += (c_Next.f32_SolarY - c_Entry.f32_SolarY) * f32_Weight;
+    }
+}
@@ -0,0 +1,174 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef DayCycle_h
+#define DayCycle_h
+
+// C / C++
+#include <vector>
+
+// External
+#include <SDL2/SDL.h>
+
+// Project
+#include "./Exception.h"
+
+
+class DayCycle
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    typedef enum
+    {
+        SUN = 0,
+        MOON = 1,
+        
+        SOLAR_BODY_MAX = MOON,
+        
+        SOLAR_BODY_COUNT = SOLAR_BODY_MAX + 1
+        
+    }SolarBody;
+    
+    struct Entry
+    {
+        // Asset tint color
+        SDL_Color c_Tint;
+        
+        // Solar body position in multiples of the width, y is relative
+        // to the bottom edge
+        float f32_SolarX;
+        float f32_SolarY;
+        
+        SolarBody e_SolarBody;
+    };
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor. The schedule is read from the day cycle file if
+     *  it exists, the default schedule is used otherwise.
+     */
+    
+    DayCycle() noexcept;
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_DayCycle DayCycle class source.
+     */
+    
+    DayCycle(DayCycle const& c_DayCycle) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~DayCycle() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the day cycle entry for a time of day.
+     *
+     *  \param i_Hours The hour of the day.
+     *  \param i_Minutes The minute of the hour.
+     *
+     *  \return The day cycle entry.
+     */
+    
+    Entry const& GetEntry(int i_Hours, int i_Minutes) const noexcept;
+    
+    /**
+     *  Get the solar body position between two minutes of the day. The 
+     *  position is not interpolated if the solar body changes.
+     *
+     *  \param i_Hours The hour of the day.
+     *  \param i_Minutes The minute of the hour.
+     *  \param f32_Offset The minutes passed since the given minute, 
+     *                    between -1 and 1.
+     *  \param f32_X The solar body x position in multiples of the width.
+     *  \param f32_Y The solar body y position in multiples of the width.
+     */
+    
+    void GetSolarPosition(int i_Hours, int i_Minutes, float f32_Offset, float& f32_X, float& f32_Y) const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct Phase
+    {
+        // Minute of the day the phase begins
+        int i_Begin;
+        
+        // Minutes to blend from the previous phase color
+        int i_Transition;
+        
+        SDL_Color c_Color;
+    };
+    
+    //*************************************************************************************
+    // Schedule
+    //*************************************************************************************
+    
+    /**
+     *  Read the schedule from the day cycle file.
+     */
+    
+    void ReadSchedule();
+    
+    /**
+     *  Set the default schedule.
+     */
+    
+    void SetDefaultSchedule() noexcept;
+    
+    //*************************************************************************************
+    // Build
+    //*************************************************************************************
+    
+    /**
+     *  Build the entry table for every minute of the day.
+     */
+    
+    void Build() noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::vector<Phase> v_Phase;
+    
+    int i_SunRise;
+    int i_SunSet;
+    
+    Entry p_Entry[24 * 60];
+    
+protected:
+    
+};
+
+#endif /* DayCycle_h */
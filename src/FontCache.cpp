@@ -0,0 +1,134 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <climits>
+
+// External
+
+// Project
+#include "./FontCache.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+FontCache::FontCache() noexcept
+{}
+
+FontCache::~FontCache() noexcept
+{
+    // Fonts read from the mapped files, close them first
+    for (auto& Font : m_Font)
+    {
+        TTF_CloseFont(Font.second);
+    }
+    
+    for (auto& File : m_File)
+    {
+        munmap(File.second.p_Data, File.second.us_Size);
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+TTF_Font* FontCache::GetFont(std::string const& s_FilePath, int i_Size)
+{
+    auto Font = m_Font.find(std::make_pair(s_FilePath, i_Size));
+    
+    if (Font != m_Font.end())
+    {
+        return Font->second;
+    }
+    
+    // Not opened yet, open from the file in memory
+    FontFile const& c_File = GetFile(s_FilePath);
+    SDL_RWops* p_RW = SDL_RWFromConstMem(c_File.p_Data, (int)(c_File.us_Size));
+    TTF_Font* p_Font = NULL;
+    
+    if (p_RW == NULL || (p_Font = TTF_OpenFontRW(p_RW, 1, i_Size)) == NULL)
+    {
+        throw Exception("Failed to load font file: " + s_FilePath + "!");
+    }
+    
+    try
+    {
+        m_Font.insert(std::make_pair(std::make_pair(s_FilePath, i_Size), p_Font));
+    }
+    catch (...)
+    {
+        TTF_CloseFont(p_Font);
+        throw Exception("Failed to store font!");
+    }
+    
+    return p_Font;
+}
+
+//*************************************************************************************
+// File
+//*************************************************************************************
+
+FontCache::FontFile const& FontCache::GetFile(std::string const& s_FilePath)
+{
+    auto File = m_File.find(s_FilePath);
+    
+    if (File != m_File.end())
+    {
+        return File->second;
+    }
+    
+    // Map the whole file once, fonts read from it on demand
+    int i_FD = open(s_FilePath.c_str(), O_RDONLY | O_CLOEXEC);
+    struct stat c_Stat;
+    
+    if (i_FD < 0)
+    {
+        throw Exception("Failed to open font file: " + s_FilePath + "!");
+    }
+    else if (fstat(i_FD, &c_Stat) < 0 || c_Stat.st_size <= 0 || c_Stat.st_size > INT_MAX)
+    {
+        close(i_FD);
+        throw Exception("Invalid font file: " + s_FilePath + "!");
+    }
+    
+    FontFile c_File;
+    c_File.us_Size = (size_t)(c_Stat.st_size);
+    c_File.p_Data = mmap(NULL, c_File.us_Size, PROT_READ, MAP_PRIVATE, i_FD, 0);
+    
+    close(i_FD);
+    
+    if (c_File.p_Data == MAP_FAILED)
+    {
+        throw Exception("Failed to map font file: " + s_FilePath + "!");
+    }
+    
+    try
+    {
+        return m_File.insert(std::make_pair(s_FilePath, c_File)).first->second;
+    }
+    catch (...)
+    {
+        munmap(c_File.p_Data, c_File.us_Size);
+        throw Exception("Failed to store font file!");
+    }
+}
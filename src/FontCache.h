@@ -0,0 +1,112 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef FontCache_h
+#define FontCache_h
+
+// C / C++
+#include <map>
+#include <string>
+
+// External
+#include <SDL2/SDL_ttf.h>
+
+// Project
+#include "./Exception.h"
+
+
+class FontCache
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    FontCache() noexcept;
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_FontCache FontCache class source.
+     */
+    
+    FontCache(FontCache const& c_FontCache) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~FontCache() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get a font. The font file is read once and the font stays open until
+     *  the cache is destroyed.
+     *
+     *  \param s_FilePath The path to the font file.
+     *  \param i_Size The font point size.
+     *
+     *  \return The requested font.
+     */
+    
+    TTF_Font* GetFont(std::string const& s_FilePath, int i_Size);
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct FontFile
+    {
+        void* p_Data;
+        size_t us_Size;
+    };
+    
+    //*************************************************************************************
+    // File
+    //*************************************************************************************
+    
+    /**
+     *  Get the mapped font file data.
+     *
+     *  \param s_FilePath The path to the font file.
+     *
+     *  \return The font file data.
+     */
+    
+    FontFile const& GetFile(std::string const& s_FilePath);
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::map<std::string, FontFile> m_File;
+    std::map<std::pair<std::string, int>, TTF_Font*> m_Font;
+    
+protected:
+    
+};
+
+#endif /* FontCache_h */
@@ -0,0 +1,96 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <ctime>
+#include <cerrno>
+
+// External
+
+// Project
+#include "./FramePacer.h"
+#include "./Profiler.h"
+
+// Pre-defined
+namespace
+{
+    // The scheduler wakes up late, spin for the remaining time
+    constexpr uint64_t u64_SpinTime = 500 * 1000;
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+FramePacer::FramePacer(Mode e_Mode, int i_FrameRate) noexcept : e_Mode(e_Mode),
+                                                                u64_Interval(i_FrameRate > 0 ? 1000000000ULL / (uint64_t)i_FrameRate : 0),
+                                                                u64_Next(0)
+{}
+
+FramePacer::~FramePacer() noexcept
+{}
+
+//*************************************************************************************
+// Wait
+//*************************************************************************************
+
+void FramePacer::Wait() noexcept
+{
+    if (u64_Interval == 0)
+    {
+        return;
+    }
+    
+    uint64_t u64_Now = Profiler::GetTime();
+    
+    if (u64_Now < u64_Next)
+    {
+        if (u64_Next - u64_Now > u64_SpinTime)
+        {
+            uint64_t u64_Wake = u64_Next - u64_SpinTime;
+            struct timespec c_Wake;
+            
+            c_Wake.tv_sec = (time_t)(u64_Wake / 1000000000ULL);
+            c_Wake.tv_nsec = (long)(u64_Wake % 1000000000ULL);
+            
+            while (clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &c_Wake, NULL) == EINTR)
+            {}
+        }
+        
+        while ((u64_Now = Profiler::GetTime()) < u64_Next)
+        {}
+    }
+    
+    // Keep a steady schedule unless we fell behind
+    if (u64_Now - u64_Next >= u64_Interval)
+    {
+        u64_Next = u64_Now + u64_Interval;
+    }
+    else
+    {
+        u64_Next += u64_Interval;
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+FramePacer::Mode FramePacer::GetMode() const noexcept
+{
+    return e_Mode;
+}
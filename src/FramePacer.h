@@ -0,0 +1,104 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef FramePacer_h
+#define FramePacer_h
+
+// C / C++
+#include <cstdint>
+
+// External
+
+// Project
+
+
+class FramePacer
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    typedef enum
+    {
+        UPDATE = 0, // Draw only when a component update is due
+        CONTINUOUS = 1, // Draw every frame, paced by vsync and the frame cap
+        
+        MODE_MAX = CONTINUOUS,
+        
+        MODE_COUNT = MODE_MAX + 1
+        
+    }Mode;
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *  
+     *  \param e_Mode The pacing mode.
+     *  \param i_FrameRate The maximum frames per second, 0 for no limit.
+     */
+    
+    FramePacer(Mode e_Mode, int i_FrameRate) noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~FramePacer() noexcept;
+    
+    //*************************************************************************************
+    // Wait
+    //*************************************************************************************
+    
+    /**
+     *  Wait until the next frame may be drawn. Frames which are late by more
+     *  than one interval restart the schedule instead of catching up.
+     */
+    
+    void Wait() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the pacing mode.
+     *  
+     *  \return The pacing mode.
+     */
+    
+    Mode GetMode() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    Mode e_Mode;
+    
+    uint64_t u64_Interval; // Nanoseconds, 0 if unlimited
+    uint64_t u64_Next;
+    
+protected:
+    
+};
+
+#endif /* FramePacer_h */
@@ -0,0 +1,195 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+
+// External
+
+// Project
+#include "./GlyphAtlas.h"
+
+// Pre-defined
+namespace
+{
+    constexpr size_t us_GlyphCount = 128;
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+GlyphAtlas::GlyphAtlas(SDL_Renderer* p_Renderer,
+                       TTF_Font* p_Font,
+                       std::string const& s_Characters) : p_Texture(NULL)
+{
+    SDL_Surface* p_Rendered[us_GlyphCount] = { NULL };
+    SDL_Color c_Color = { 255, 255, 255 };
+    int i_W = 0;
+    int i_H = 0;
+    
+    for (size_t i = 0; i < us_GlyphCount; ++i)
+    {
+        p_Glyph[i] = { 0, 0, 0, 0 };
+    }
+    
+    // Rasterize all glyphs once, placed next to each other
+    for (char c_Character : s_Characters)
+    {
+        size_t us_Glyph = (unsigned char)c_Character;
+        
+        if (us_Glyph >= us_GlyphCount || p_Rendered[us_Glyph] != NULL)
+        {
+            continue;
+        }
+        
+        char p_String[2] = { c_Character, '\0' };
+        
+        if ((p_Rendered[us_Glyph] = TTF_RenderUTF8_Blended(p_Font, p_String, c_Color)) == NULL)
+        {
+            continue;
+        }
+        
+        p_Glyph[us_Glyph] = { i_W, 0, p_Rendered[us_Glyph]->w, p_Rendered[us_Glyph]->h };
+        
+        i_W += p_Rendered[us_Glyph]->w;
+        i_H = (i_H < p_Rendered[us_Glyph]->h ? p_Rendered[us_Glyph]->h : i_H);
+    }
+    
+    // Copy glyphs to the atlas surface, keeping their alpha
+    SDL_Surface* p_Surface = NULL;
+    
+    if (i_W > 0 && i_H > 0)
+    {
+        p_Surface = SDL_CreateRGBSurfaceWithFormat(0, i_W, i_H, 32, SDL_PIXELFORMAT_RGBA32);
+    }
+    
+    if (p_Surface != NULL)
+    {
+        SDL_FillRect(p_Surface, NULL, 0);
+        
+        for (size_t i = 0; i < us_GlyphCount; ++i)
+        {
+            if (p_Rendered[i] != NULL)
+            {
+                SDL_Rect c_Rect = p_Glyph[i];
+                
+                SDL_SetSurfaceBlendMode(p_Rendered[i], SDL_BLENDMODE_NONE);
+                SDL_BlitSurface(p_Rendered[i], NULL, p_Surface, &c_Rect);
+            }
+        }
+        
+        p_Texture = SDL_CreateTextureFromSurface(p_Renderer, p_Surface);
+        SDL_FreeSurface(p_Surface);
+    }
+    
+    for (size_t i = 0; i < us_GlyphCount; ++i)
+    {
+        if (p_Rendered[i] != NULL)
+        {
+            SDL_FreeSurface(p_Rendered[i]);
+        }
+    }
+    
+    if (p_Texture == NULL)
+    {
+        throw Exception("Failed to create glyph atlas texture!");
+    }
+    
+    SDL_SetTextureBlendMode(p_Texture, SDL_BLENDMODE_BLEND);
+}
+
+GlyphAtlas::~GlyphAtlas() noexcept
+{
+    if (p_Texture != NULL)
+    {
+        SDL_DestroyTexture(p_Texture);
+    }
+}
+
+//*************************************************************************************
+// Draw
+//*************************************************************************************
+
+bool GlyphAtlas::Draw(SDL_Renderer* p_Renderer, const char* p_String, SDL_Rect const& c_Rect) const noexcept
+{
+    int i_W;
+    int i_H;
+    
+    if (GetSize(p_String, i_W, i_H) == false || i_W == 0)
+    {
+        return false;
+    }
+    
+    // Place each glyph at its scaled pen position
+    SDL_Rect c_Glyph = { c_Rect.x, c_Rect.y, 0, c_Rect.h };
+    int i_Pen = 0;
+    
+    for (; *p_String != '\0'; ++p_String)
+    {
+        SDL_Rect const& c_Source = p_Glyph[(unsigned char)*p_String];
+        
+        c_Glyph.x = c_Rect.x + ((i_Pen * c_Rect.w) / i_W);
+        i_Pen += c_Source.w;
+        c_Glyph.w = (c_Rect.x + ((i_Pen * c_Rect.w) / i_W)) - c_Glyph.x;
+        
+        if (SDL_RenderCopy(p_Renderer, p_Texture, &c_Source, &c_Glyph) < 0)
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+bool GlyphAtlas::GetSize(const char* p_String, int& i_W, int& i_H) const noexcept
+{
+    i_W = 0;
+    i_H = 0;
+    
+    for (; *p_String != '\0'; ++p_String)
+    {
+        size_t us_Glyph = (unsigned char)*p_String;
+        
+        if (us_Glyph >= us_GlyphCount || p_Glyph[us_Glyph].w == 0)
+        {
+            return false;
+        }
+        
+        i_W += p_Glyph[us_Glyph].w;
+        i_H = (i_H < p_Glyph[us_Glyph].h ? p_Glyph[us_Glyph].h : i_H);
+    }
+    
+    return true;
+}
+
+size_t GlyphAtlas::GetTextureBytes() const noexcept
+{
+    Uint32 u32_Format;
+    int i_W;
+    int i_H;
+    
+    if (SDL_QueryTexture(p_Texture, &u32_Format, NULL, &i_W, &i_H) < 0)
+    {
+        return 0;
+    }
+    
+    return (size_t)(SDL_BYTESPERPIXEL(u32_Format)) * i_W * i_H;
+}
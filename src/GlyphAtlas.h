@@ -0,0 +1,121 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef GlyphAtlas_h
+#define GlyphAtlas_h
+
+// C / C++
+#include <string>
+
+// External
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_ttf.h>
+
+// Project
+#include "./Exception.h"
+
+
+class GlyphAtlas
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param p_Renderer The renderer to create the atlas texture with.
+     *  \param p_Font The font to rasterize the glyphs with.
+     *  \param s_Characters The ASCII characters to add to the atlas.
+     */
+    
+    GlyphAtlas(SDL_Renderer* p_Renderer,
+               TTF_Font* p_Font,
+               std::string const& s_Characters);
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_GlyphAtlas GlyphAtlas class source.
+     */
+    
+    GlyphAtlas(GlyphAtlas const& c_GlyphAtlas) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~GlyphAtlas() noexcept;
+    
+    //*************************************************************************************
+    // Draw
+    //*************************************************************************************
+    
+    /**
+     *  Draw a string with the atlas glyphs. The string is scaled to fit the
+     *  given area.
+     *
+     *  \param p_Renderer The renderer to draw with.
+     *  \param p_String The string to draw.
+     *  \param c_Rect The area to draw the string to.
+     *
+     *  \return true if the string was drawn, false if not.
+     */
+    
+    bool Draw(SDL_Renderer* p_Renderer, const char* p_String, SDL_Rect const& c_Rect) const noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the unscaled size of a string drawn with the atlas.
+     *
+     *  \param p_String The string to measure.
+     *  \param i_W The string width.
+     *  \param i_H The string height.
+     *
+     *  \return true if all characters are in the atlas, false if not.
+     */
+    
+    bool GetSize(const char* p_String, int& i_W, int& i_H) const noexcept;
+    
+    /**
+     *  Get the memory used by the atlas texture.
+     *
+     *  \return The texture memory in bytes.
+     */
+    
+    size_t GetTextureBytes() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    SDL_Texture* p_Texture;
+    
+    // Glyph source rects by ASCII value, w is 0 for missing glyphs
+    SDL_Rect p_Glyph[128];
+    
+protected:
+    
+};
+
+#endif /* GlyphAtlas_h */
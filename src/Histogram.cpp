@@ -0,0 +1,139 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstring>
+#include <cmath>
+
+// External
+
+// Project
+#include "./Histogram.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Histogram::Histogram() noexcept
+{
+    Reset();
+}
+
+Histogram::~Histogram() noexcept
+{}
+
+//*************************************************************************************
+// Add
+//*************************************************************************************
+
+void Histogram::Add(uint64_t u64_Value) noexcept
+{
+    p_Bucket[GetBucket(u64_Value)] += 1;
+    u64_Count += 1;
+    
+    if (u64_Max < u64_Value)
+    {
+        u64_Max = u64_Value;
+    }
+}
+
+void Histogram::Reset() noexcept
+{
+    memset(p_Bucket, 0, sizeof(p_Bucket));
+    u64_Count = 0;
+    u64_Max = 0;
+}
+
+//*************************************************************************************
+// Buckets
+//*************************************************************************************
+
+size_t Histogram::GetBucket(uint64_t u64_Value) noexcept
+{
+    // Small values map directly
+    if (u64_Value < us_SubBucketCount)
+    {
+        return (size_t)u64_Value;
+    }
+    
+    size_t us_Bits = 63 - __builtin_clzll(u64_Value);
+    
+    if (us_Bits >= us_MaxBits)
+    {
+        return us_BucketCount - 1;
+    }
+    
+    // Top bits of the value select the sub bucket
+    size_t us_Shift = us_Bits - us_SubBucketBits;
+    return (us_Shift * us_SubBucketCount) + (size_t)(u64_Value >> us_Shift);
+}
+
+uint64_t Histogram::GetBucketValue(size_t us_Bucket) noexcept
+{
+    if (us_Bucket < us_SubBucketCount * 2)
+    {
+        return us_Bucket;
+    }
+    
+    size_t us_Shift = (us_Bucket / us_SubBucketCount) - 1;
+    uint64_t u64_Top = (us_Bucket % us_SubBucketCount) + us_SubBucketCount;
+    
+    return ((u64_Top + 1) << us_Shift) - 1;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+uint64_t Histogram::GetPercentile(double f64_Percentile) const noexcept
+{
+    if (u64_Count == 0)
+    {
+        return 0;
+    }
+    
+    uint64_t u64_Target = (uint64_t)(std::ceil((f64_Percentile / 100.0) * u64_Count));
+    uint64_t u64_Seen = 0;
+    
+    if (u64_Target == 0)
+    {
+        u64_Target = 1;
+    }
+    
+    for (size_t i = 0; i < us_BucketCount; ++i)
+    {
+        u64_Seen += p_Bucket[i];
+        
+        if (u64_Seen >= u64_Target)
+        {
+            uint64_t u64_Value = GetBucketValue(i);
+            return u64_Value < u64_Max ? u64_Value : u64_Max;
+        }
+    }
+    
+    return u64_Max;
+}
+
+uint64_t Histogram::GetMax() const noexcept
+{
+    return u64_Max;
+}
+
+uint64_t Histogram::GetCount() const noexcept
+{
+    return u64_Count;
+}
@@ -0,0 +1,144 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Histogram_h
+#define Histogram_h
+
+// C / C++
+#include <cstdint>
+#include <cstddef>
+
+// External
+
+// Project
+
+
+class Histogram
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    Histogram() noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Histogram() noexcept;
+    
+    //*************************************************************************************
+    // Add
+    //*************************************************************************************
+    
+    /**
+     *  Add a value to the histogram. Values are stored with a relative
+     *  precision of about 3%.
+     *
+     *  \param u64_Value The value to add.
+     */
+    
+    void Add(uint64_t u64_Value) noexcept;
+    
+    /**
+     *  Remove all values from the histogram.
+     */
+    
+    void Reset() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the value at a percentile.
+     *
+     *  \param f64_Percentile The percentile to get, in the range 0 - 100.
+     *
+     *  \return The highest value equivalent to the percentile, 0 if empty.
+     */
+    
+    uint64_t GetPercentile(double f64_Percentile) const noexcept;
+    
+    /**
+     *  Get the largest added value.
+     *
+     *  \return The largest added value.
+     */
+    
+    uint64_t GetMax() const noexcept;
+    
+    /**
+     *  Get the number of added values.
+     *
+     *  \return The number of added values.
+     */
+    
+    uint64_t GetCount() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Buckets
+    //*************************************************************************************
+    
+    /**
+     *  Get the bucket for a value.
+     *
+     *  \param u64_Value The value to get the bucket for.
+     *
+     *  \return The bucket index.
+     */
+    
+    static size_t GetBucket(uint64_t u64_Value) noexcept;
+    
+    /**
+     *  Get the highest value stored in a bucket.
+     *
+     *  \param us_Bucket The bucket index.
+     *
+     *  \return The highest bucket value.
+     */
+    
+    static uint64_t GetBucketValue(size_t us_Bucket) noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    // Each power of two is split into 2^5 linear sub buckets, values
+    // above 2^40 are clamped
+    static constexpr size_t us_SubBucketBits = 5;
+    static constexpr size_t us_SubBucketCount = 1 << us_SubBucketBits;
+    static constexpr size_t us_MaxBits = 40;
+    static constexpr size_t us_BucketCount = ((us_MaxBits - us_SubBucketBits) + 2) * us_SubBucketCount;
+    
+    uint32_t p_Bucket[us_BucketCount];
+    
+    uint64_t u64_Count;
+    uint64_t u64_Max;
+    
+protected:
+    
+};
+
+#endif /* Histogram_h */
@@ -62,10 +62,7 @@ namespace
 
 Locale::Locale() : s_Active("")
 {
-    Logger& c_Logger = Logger::Singleton();
-    
-    c_Logger.Log(Logger::INFO, "Reading " MRH_LOCALE_FILE_PATH " locale config...",
-                 "Locale.cpp", __LINE__);
+    MRANGEUI_LOG_INFO("Reading " MRH_LOCALE_FILE_PATH " locale config...");
     
     try
     {
@@ -87,8 +84,7 @@ Locale::Locale() : s_Active("")
         throw Exception(e.what());
     }
     
-    c_Logger.Log(Logger::INFO, "Read locale config.",
-                 "Locale.cpp", __LINE__);
+    MRANGEUI_LOG_INFO("Read locale config.");
 }
 
 Locale::~Locale() noexcept
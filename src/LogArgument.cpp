@@ -0,0 +1,182 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstdio>
+
+// External
+
+// Project
+#include "./LogArgument.h"
+
+// Pre-defined
+namespace
+{
+    constexpr size_t us_MaxStringSize = 0xFFFF;
+}
+
+
+//*************************************************************************************
+// Encode
+//*************************************************************************************
+
+size_t LogArgument::Encode(uint8_t* p_Buffer, size_t us_Size, const char* p_String) noexcept
+{
+    if (p_String == NULL)
+    {
+        p_String = "(null)";
+    }
+    
+    // Type and size first, then as many characters as fit
+    if (us_Size < 1 + sizeof(uint16_t))
+    {
+        return 0;
+    }
+    
+    size_t us_Length = strlen(p_String);
+    size_t us_Free = us_Size - (1 + sizeof(uint16_t));
+    
+    if (us_Length > us_Free)
+    {
+        us_Length = us_Free;
+    }
+    
+    if (us_Length > us_MaxStringSize)
+    {
+        us_Length = us_MaxStringSize;
+    }
+    
+    uint16_t u16_Length = (uint16_t)us_Length;
+    
+    p_Buffer[0] = (uint8_t)STRING;
+    memcpy(p_Buffer + 1, &u16_Length, sizeof(uint16_t));
+    memcpy(p_Buffer + 1 + sizeof(uint16_t), p_String, us_Length);
+    
+    return 1 + sizeof(uint16_t) + us_Length;
+}
+
+size_t LogArgument::Encode(uint8_t* p_Buffer, size_t us_Size, std::string const& s_String) noexcept
+{
+    return Encode(p_Buffer, us_Size, s_String.c_str());
+}
+
+//*************************************************************************************
+// Format
+//*************************************************************************************
+
+std::string LogArgument::Format(const char* p_Format, uint8_t const* p_Argument, size_t us_Size) noexcept
+{
+    std::string s_Message;
+    size_t us_Read = 0;
+    
+    while (*p_Format != '\0')
+    {
+        if (p_Format[0] != '{' || p_Format[1] != '}' || us_Read >= us_Size)
+        {
+            s_Message += *p_Format;
+            ++p_Format;
+            continue;
+        }
+        
+        p_Format += 2;
+        
+        // Replace with the next argument
+        uint8_t u8_Type = p_Argument[us_Read++];
+        char p_Value[32];
+        
+        switch (u8_Type)
+        {
+            case INT:
+            {
+                int64_t s64_Value;
+                
+                if (us_Size - us_Read < sizeof(int64_t))
+                {
+                    return s_Message;
+                }
+                
+                memcpy(&s64_Value, p_Argument + us_Read, sizeof(int64_t));
+                us_Read += sizeof(int64_t);
+                
+                snprintf(p_Value, sizeof(p_Value), "%lld", (long long)s64_Value);
+                s_Message += p_Value;
+                break;
+            }
+            
+            case UINT:
+            {
+                uint64_t u64_Value;
+                
+                if (us_Size - us_Read < sizeof(uint64_t))
+                {
+                    return s_Message;
+                }
+                
+                memcpy(&u64_Value, p_Argument + us_Read, sizeof(uint64_t));
+                us_Read += sizeof(uint64_t);
+                
+                snprintf(p_Value, sizeof(p_Value), "%llu", (unsigned long long)u64_Value);
+                s_Message += p_Value;
+                break;
+            }
+            
+            case DOUBLE:
+            {
+                double f64_Value;
+                
+                if (us_Size - us_Read < sizeof(double))
+                {
+                    return s_Message;
+                }
+                
+                memcpy(&f64_Value, p_Argument + us_Read, sizeof(double));
+                us_Read += sizeof(double);
+                
+                snprintf(p_Value, sizeof(p_Value), "%g", f64_Value);
+                s_Message += p_Value;
+                break;
+            }
+            
+            case STRING:
+            {
+                uint16_t u16_Length;
+                
+                if (us_Size - us_Read < sizeof(uint16_t))
+                {
+                    return s_Message;
+                }
+                
+                memcpy(&u16_Length, p_Argument + us_Read, sizeof(uint16_t));
+                us_Read += sizeof(uint16_t);
+                
+                if (us_Size - us_Read < u16_Length)
+                {
+                    return s_Message;
+                }
+                
+                s_Message.append((const char*)(p_Argument + us_Read), u16_Length);
+                us_Read += u16_Length;
+                break;
+            }
+            
+            default:
+                // Unknown argument, the rest can't be read
+                return s_Message;
+        }
+    }
+    
+    return s_Message;
+}
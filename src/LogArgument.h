@@ -0,0 +1,196 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef LogArgument_h
+#define LogArgument_h
+
+// C / C++
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+
+// External
+
+// Project
+
+
+class LogArgument
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    typedef enum
+    {
+        INT = 0, // int64_t
+        UINT = 1, // uint64_t
+        DOUBLE = 2, // double
+        STRING = 3, // uint16_t size, followed by the characters
+        
+        ARGUMENT_TYPE_MAX = STRING,
+        
+        ARGUMENT_TYPE_COUNT = ARGUMENT_TYPE_MAX + 1
+        
+    }ArgumentType;
+    
+    //*************************************************************************************
+    // Encode
+    //*************************************************************************************
+    
+    /**
+     *  Encode a signed integer argument.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param Value The value to encode.
+     *
+     *  \return The encoded size, 0 if the argument did not fit.
+     */
+    
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_signed<T>::value, size_t>::type Encode(uint8_t* p_Buffer, size_t us_Size, T Value) noexcept
+    {
+        return EncodeValue(p_Buffer, us_Size, INT, (int64_t)Value);
+    }
+    
+    /**
+     *  Encode an unsigned integer argument.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param Value The value to encode.
+     *
+     *  \return The encoded size, 0 if the argument did not fit.
+     */
+    
+    template<typename T>
+    static typename std::enable_if<std::is_integral<T>::value && std::is_unsigned<T>::value, size_t>::type Encode(uint8_t* p_Buffer, size_t us_Size, T Value) noexcept
+    {
+        return EncodeValue(p_Buffer, us_Size, UINT, (uint64_t)Value);
+    }
+    
+    /**
+     *  Encode an enum argument.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param Value The value to encode.
+     *
+     *  \return The encoded size, 0 if the argument did not fit.
+     */
+    
+    template<typename T>
+    static typename std::enable_if<std::is_enum<T>::value, size_t>::type Encode(uint8_t* p_Buffer, size_t us_Size, T Value) noexcept
+    {
+        return EncodeValue(p_Buffer, us_Size, INT, (int64_t)Value);
+    }
+    
+    /**
+     *  Encode a floating point argument.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param Value The value to encode.
+     *
+     *  \return The encoded size, 0 if the argument did not fit.
+     */
+    
+    template<typename T>
+    static typename std::enable_if<std::is_floating_point<T>::value, size_t>::type Encode(uint8_t* p_Buffer, size_t us_Size, T Value) noexcept
+    {
+        return EncodeValue(p_Buffer, us_Size, DOUBLE, (double)Value);
+    }
+    
+    /**
+     *  Encode a string argument. The string is truncated to fit.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param p_String The string to encode.
+     *
+     *  \return The encoded size, 0 if the argument did not fit.
+     */
+    
+    static size_t Encode(uint8_t* p_Buffer, size_t us_Size, const char* p_String) noexcept;
+    
+    /**
+     *  Encode a string argument. The string is truncated to fit.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param s_String The string to encode.
+     *
+     *  \return The encoded size, 0 if the argument did not fit.
+     */
+    
+    static size_t Encode(uint8_t* p_Buffer, size_t us_Size, std::string const& s_String) noexcept;
+    
+    //*************************************************************************************
+    // Format
+    //*************************************************************************************
+    
+    /**
+     *  Create a message from a format and encoded arguments. Each {} in the
+     *  format is replaced by the next argument.
+     *
+     *  \param p_Format The message format.
+     *  \param p_Argument The encoded arguments.
+     *  \param us_Size The encoded arguments size.
+     *
+     *  \return The message.
+     */
+    
+    static std::string Format(const char* p_Format, uint8_t const* p_Argument, size_t us_Size) noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Encode
+    //*************************************************************************************
+    
+    /**
+     *  Encode a fixed size argument.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param e_Type The argument type.
+     *  \param Value The value to encode.
+     *
+     *  \return The encoded size, 0 if the argument did not fit.
+     */
+    
+    template<typename T>
+    static size_t EncodeValue(uint8_t* p_Buffer, size_t us_Size, ArgumentType e_Type, T Value) noexcept
+    {
+        if (us_Size < 1 + sizeof(T))
+        {
+            return 0;
+        }
+        
+        p_Buffer[0] = (uint8_t)e_Type;
+        memcpy(p_Buffer + 1, &Value, sizeof(T));
+        
+        return 1 + sizeof(T);
+    }
+    
+protected:
+    
+};
+
+#endif /* LogArgument_h */
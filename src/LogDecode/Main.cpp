@@ -0,0 +1,208 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <cstdio>
+#include <map>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+// External
+
+// Project
+#include "../LogArgument.h"
+
+// Pre-defined
+namespace
+{
+    // Binary log file header
+    const char p_BinaryMagic[4] = { 'M', 'R', 'L', 'B' };
+    constexpr uint32_t u32_BinaryVersion = 2;
+    
+    const char* p_LevelString[] =
+    {
+        "INFO",
+        "WARNING",
+        "ERROR"
+    };
+    
+    constexpr size_t us_LevelCount = sizeof(p_LevelString) / sizeof(const char*);
+    
+    // Call site from the side table
+    struct Site
+    {
+        std::string s_File;
+        std::string s_Line;
+        std::string s_Format;
+        bool b_Truncated;
+    };
+}
+
+
+//*************************************************************************************
+// Table
+//*************************************************************************************
+
+static bool ReadTable(std::string const& s_FilePath, std::map<uint32_t, Site>& m_Site) noexcept
+{
+    std::ifstream f_File(s_FilePath);
+    std::string s_Line;
+    
+    if (f_File.is_open() == false)
+    {
+        return false;
+    }
+    
+    // id, file, line, truncation flag and format separated by tabs
+    while (std::getline(f_File, s_Line))
+    {
+        size_t us_File = s_Line.find('\t');
+        size_t us_Line = (us_File == std::string::npos ? us_File : s_Line.find('\t', us_File + 1));
+        size_t us_Truncated = (us_Line == std::string::npos ? us_Line : s_Line.find('\t', us_Line + 1));
+        size_t us_Format = (us_Truncated == std::string::npos ? us_Truncated : s_Line.find('\t', us_Truncated + 1));
+        
+        if (us_Format == std::string::npos)
+        {
+            continue;
+        }
+        
+        Site& c_Site = m_Site[(uint32_t)strtoul(s_Line.c_str(), NULL, 10)];
+        
+        c_Site.s_File = s_Line.substr(us_File + 1, us_Line - us_File - 1);
+        c_Site.s_Line = s_Line.substr(us_Line + 1, us_Truncated - us_Line - 1);
+        c_Site.b_Truncated = (s_Line.compare(us_Truncated + 1, us_Format - us_Truncated - 1, "1") == 0);
+        c_Site.s_Format = s_Line.substr(us_Format + 1);
+    }
+    
+    return true;
+}
+
+//*************************************************************************************
+// Log
+//*************************************************************************************
+
+template<typename T>
+static bool ReadValue(std::ifstream& f_File, T& Value) noexcept
+{
+    return f_File.read((char*)&Value, sizeof(T)).gcount() == sizeof(T);
+}
+
+static std::string GetTimeString(uint64_t u64_Time) noexcept
+{
+    time_t us_Seconds = (time_t)(u64_Time / 1000000000ULL);
+    struct tm c_LocalTime;
+    char p_Time[64];
+    char p_Result[80];
+    
+    localtime_r(&us_Seconds, &c_LocalTime);
+    strftime(p_Time, sizeof(p_Time), "%Y-%m-%d %H:%M:%S", &c_LocalTime);
+    snprintf(p_Result, sizeof(p_Result), "%s.%03u", p_Time, (unsigned)((u64_Time / 1000000ULL) % 1000));
+    
+    return p_Result;
+}
+
+static bool DecodeLog(std::string const& s_FilePath, std::map<uint32_t, Site> const& m_Site) noexcept
+{
+    std::ifstream f_File(s_FilePath, std::ios::in | std::ios::binary);
+    char p_Magic[sizeof(p_BinaryMagic)];
+    uint32_t u32_Version;
+    
+    if (f_File.is_open() == false ||
+        f_File.read(p_Magic, sizeof(p_Magic)).gcount() != sizeof(p_Magic) ||
+        memcmp(p_Magic, p_BinaryMagic, sizeof(p_Magic)) != 0 ||
+        ReadValue(f_File, u32_Version) == false ||
+        u32_Version != u32_BinaryVersion)
+    {
+        return false;
+    }
+    
+    std::vector<uint8_t> v_Argument;
+    uint32_t u32_Site;
+    uint8_t u8_Level;
+    uint64_t u64_Time;
+    uint16_t u16_Size;
+    
+    // Record: site, level, time, argument size, arguments
+    while (ReadValue(f_File, u32_Site) == true)
+    {
+        if (ReadValue(f_File, u8_Level) == false ||
+            ReadValue(f_File, u64_Time) == false ||
+            ReadValue(f_File, u16_Size) == false)
+        {
+            std::cerr << "Truncated record!" << std::endl;
+            return false;
+        }
+        
+        v_Argument.resize(u16_Size);
+        
+        if (u16_Size > 0 && f_File.read((char*)v_Argument.data(), u16_Size).gcount() != u16_Size)
+        {
+            std::cerr << "Truncated record!" << std::endl;
+            return false;
+        }
+        
+        auto Site = m_Site.find(u32_Site);
+        
+        std::cout << "[" << GetTimeString(u64_Time) << "]";
+        
+        if (Site == m_Site.end())
+        {
+            std::cout << "[?][?][" << (u8_Level < us_LevelCount ? p_LevelString[u8_Level] : "UNKNOWN") << "]: "
+                      << "Unknown call site " << u32_Site << std::endl;
+        }
+        else
+        {
+            std::cout << "[" << Site->second.s_File << "][" << Site->second.s_Line << "]["
+                      << (u8_Level < us_LevelCount ? p_LevelString[u8_Level] : "UNKNOWN") << "]: "
+                      << LogArgument::Format(Site->second.s_Format.c_str(), v_Argument.data(), v_Argument.size())
+                      << (Site->second.b_Truncated == true ? " [format truncated]" : "") << std::endl;
+        }
+    }
+    
+    return true;
+}
+
+//*************************************************************************************
+// Main
+//*************************************************************************************
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <table file> <log file>" << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    std::map<uint32_t, Site> m_Site;
+    
+    if (ReadTable(argv[1], m_Site) == false)
+    {
+        std::cerr << "Failed to read table file: " << argv[1] << std::endl;
+        return EXIT_FAILURE;
+    }
+    else if (DecodeLog(argv[2], m_Site) == false)
+    {
+        std::cerr << "Failed to decode log file: " << argv[2] << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    return EXIT_SUCCESS;
+}
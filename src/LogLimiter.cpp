@@ -0,0 +1,202 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <chrono>
+
+// External
+
+// Project
+#include "./LogLimiter.h"
+
+// Pre-defined
+namespace
+{
+    uint64_t GetKey(const char* p_File, size_t us_Line) noexcept
+    {
+        // FNV-1a over file and line, never 0
+        uint64_t u64_Hash = 14695981039346656037ULL;
+        
+        for (const char* p = p_File; *p != '\0'; ++p)
+        {
+            u64_Hash = (u64_Hash ^ (unsigned char)*p) * 1099511628211ULL;
+        }
+        
+        u64_Hash = (u64_Hash ^ us_Line) * 1099511628211ULL;
+        
+        return u64_Hash | 1;
+    }
+    
+    uint64_t GetTimeMS() noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+LogLimiter::LogLimiter(uint32_t u32_Burst, uint32_t u32_PerSecond) noexcept : u64_Burst((uint64_t)u32_Burst * 1000),
+                                                                              u64_PerSecond(u32_PerSecond)
+{
+    uint64_t u64_Now = GetTimeMS();
+    
+    for (size_t i = 0; i < us_SiteCount; ++i)
+    {
+        p_Site[i].u64_Key.store(0);
+        p_Site[i].c_Lock.clear();
+        p_Site[i].u64_Tokens = u64_Burst;
+        p_Site[i].u64_LastMS = u64_Now;
+        p_Site[i].us_Suppressed = 0;
+        p_Site[i].b_Summary = false;
+        p_Site[i].u32_Summary = 0;
+        p_Site[i].i_Level = 0;
+    }
+}
+
+LogLimiter::~LogLimiter() noexcept
+{}
+
+//*************************************************************************************
+// Site
+//*************************************************************************************
+
+LogLimiter::Site* LogLimiter::GetSite(const char* p_File, size_t us_Line) noexcept
+{
+    uint64_t u64_Key = GetKey(p_File, us_Line);
+    
+    for (size_t i = 0; i < us_MaxProbe; ++i)
+    {
+        Site& c_Site = p_Site[(u64_Key + i) & (us_SiteCount - 1)];
+        uint64_t u64_Current = c_Site.u64_Key.load(std::memory_order_acquire);
+        
+        if (u64_Current == 0 && c_Site.u64_Key.compare_exchange_strong(u64_Current, u64_Key) == true)
+        {
+            u64_Current = u64_Key;
+        }
+        
+        if (u64_Current == u64_Key)
+        {
+            return &c_Site;
+        }
+    }
+    
+    return NULL;
+}
+
+//*************************************************************************************
+// Allow
+//*************************************************************************************
+
+bool LogLimiter::Allow(const char* p_File, size_t us_Line, size_t& us_Suppressed) noexcept
+{
+    Site* p_Current = GetSite(p_File, us_Line);
+    
+    us_Suppressed = 0;
+    
+    // Table full, never limit unknown sites
+    if (p_Current == NULL)
+    {
+        return true;
+    }
+    
+    while (p_Current->c_Lock.test_and_set(std::memory_order_acquire) == true)
+    {}
+    
+    // Refill the bucket for the time passed
+    uint64_t u64_Now = GetTimeMS();
+    
+    p_Current->u64_Tokens += (u64_Now - p_Current->u64_LastMS) * u64_PerSecond;
+    p_Current->u64_LastMS = u64_Now;
+    
+    if (p_Current->u64_Tokens > u64_Burst)
+    {
+        p_Current->u64_Tokens = u64_Burst;
+    }
+    
+    bool b_Allow = p_Current->u64_Tokens >= 1000;
+    
+    if (b_Allow == true)
+    {
+        p_Current->u64_Tokens -= 1000;
+        us_Suppressed = p_Current->us_Suppressed;
+        p_Current->us_Suppressed = 0;
+    }
+    else
+    {
+        p_Current->us_Suppressed += 1;
+        us_Suppressed = p_Current->us_Suppressed;
+    }
+    
+    p_Current->c_Lock.clear(std::memory_order_release);
+    
+    return b_Allow;
+}
+
+//*************************************************************************************
+// Suppressed
+//*************************************************************************************
+
+void LogLimiter::SetSummary(const char* p_File, size_t us_Line, uint32_t u32_Summary, int i_Level) noexcept
+{
+    Site* p_Current = GetSite(p_File, us_Line);
+    
+    if (p_Current == NULL)
+    {
+        return;
+    }
+    
+    while (p_Current->c_Lock.test_and_set(std::memory_order_acquire) == true)
+    {}
+    
+    p_Current->b_Summary = true;
+    p_Current->u32_Summary = u32_Summary;
+    p_Current->i_Level = i_Level;
+    
+    p_Current->c_Lock.clear(std::memory_order_release);
+}
+
+size_t LogLimiter::TakeIdle(size_t us_Site, uint64_t u64_IdleMS, uint32_t& u32_Summary, int& i_Level) noexcept
+{
+    Site& c_Site = p_Site[us_Site & (us_SiteCount - 1)];
+    size_t us_Suppressed = 0;
+    
+    // Unused sites never suppress
+    if (c_Site.u64_Key.load(std::memory_order_acquire) == 0)
+    {
+        return 0;
+    }
+    
+    while (c_Site.c_Lock.test_and_set(std::memory_order_acquire) == true)
+    {}
+    
+    if (c_Site.us_Suppressed > 0 && 
+        c_Site.b_Summary == true &&
+        GetTimeMS() - c_Site.u64_LastMS >= u64_IdleMS)
+    {
+        us_Suppressed = c_Site.us_Suppressed;
+        u32_Summary = c_Site.u32_Summary;
+        i_Level = c_Site.i_Level;
+        
+        c_Site.us_Suppressed = 0;
+    }
+    
+    c_Site.c_Lock.clear(std::memory_order_release);
+    
+    return us_Suppressed;
+}
@@ -0,0 +1,171 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef LogLimiter_h
+#define LogLimiter_h
+
+// C / C++
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// External
+
+// Project
+
+
+class LogLimiter
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param u32_Burst The messages a call site may log at once.
+     *  \param u32_PerSecond The messages a call site may log per second after
+     *                       the burst.
+     */
+    
+    LogLimiter(uint32_t u32_Burst, uint32_t u32_PerSecond) noexcept;
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_LogLimiter LogLimiter class source.
+     */
+    
+    LogLimiter(LogLimiter const& c_LogLimiter) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~LogLimiter() noexcept;
+    
+    //*************************************************************************************
+    // Allow
+    //*************************************************************************************
+    
+    /**
+     *  Check if a call site may log a message. This function is thread safe.
+     *
+     *  \param p_File The call site source file.
+     *  \param us_Line The call site source line.
+     *  \param us_Suppressed The messages suppressed for the call site since
+     *                       the last allowed message, including this one 
+     *                       if it is not allowed.
+     *
+     *  \return true if the message may be logged, false if not.
+     */
+    
+    bool Allow(const char* p_File, size_t us_Line, size_t& us_Suppressed) noexcept;
+    
+    //*************************************************************************************
+    // Suppressed
+    //*************************************************************************************
+    
+    /**
+     *  Set the summary written for suppressed messages of a call site which 
+     *  stopped logging. This function is thread safe.
+     *
+     *  \param p_File The call site source file.
+     *  \param us_Line The call site source line.
+     *  \param u32_Summary The summary id, given back by TakeIdle().
+     *  \param i_Level The summary log level.
+     */
+    
+    void SetSummary(const char* p_File, size_t us_Line, uint32_t u32_Summary, int i_Level) noexcept;
+    
+    /**
+     *  Take the suppressed messages of a call site which did not try to log 
+     *  for a while. The messages are not reported again with the next 
+     *  allowed message. This function is thread safe.
+     *
+     *  \param us_Site The call site index, below us_SiteCount.
+     *  \param u64_IdleMS The time in milliseconds the call site has to be 
+     *                    idle.
+     *  \param u32_Summary The summary id set for the call site.
+     *  \param i_Level The summary log level set for the call site.
+     *
+     *  \return The suppressed messages, 0 if none are taken.
+     */
+    
+    size_t TakeIdle(size_t us_Site, uint64_t u64_IdleMS, uint32_t& u32_Summary, int& i_Level) noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    static constexpr size_t us_SiteCount = 256; // Power of two
+    
+private:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    struct Site
+    {
+    public:
+        
+        std::atomic<uint64_t> u64_Key; // 0 for unused
+        std::atomic_flag c_Lock;
+        
+        uint64_t u64_Tokens; // In 1/1000 tokens
+        uint64_t u64_LastMS;
+        size_t us_Suppressed;
+        
+        // Summary for suppressed messages, set by the logger
+        bool b_Summary;
+        uint32_t u32_Summary;
+        int i_Level;
+    };
+    
+    //*************************************************************************************
+    // Site
+    //*************************************************************************************
+    
+    /**
+     *  Find or claim a call site. This function is thread safe.
+     *
+     *  \param p_File The call site source file.
+     *  \param us_Line The call site source line.
+     *
+     *  \return The call site, NULL if the table is full.
+     */
+    
+    Site* GetSite(const char* p_File, size_t us_Line) noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    static constexpr size_t us_MaxProbe = 8;
+    
+    Site p_Site[us_SiteCount];
+    
+    uint64_t u64_Burst;
+    uint64_t u64_PerSecond;
+    
+protected:
+    
+};
+
+#endif /* LogLimiter_h */
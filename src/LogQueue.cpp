@@ -0,0 +1,136 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstring>
+#include <thread>
+
+// External
+
+// Project
+#include "./LogQueue.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+LogQueue::LogQueue() noexcept : us_Push(0),
+                                us_Pop(0)
+{
+    // Each record expects the position it can be pushed at
+    for (size_t i = 0; i < us_RecordCount; ++i)
+    {
+        p_Record[i].us_Sequence.store(i, std::memory_order_relaxed);
+    }
+}
+
+LogQueue::~LogQueue() noexcept
+{}
+
+//*************************************************************************************
+// Push
+//*************************************************************************************
+
+bool LogQueue::Push(uint32_t u32_Site, int i_Level, uint64_t u64_Time, uint8_t const* p_Argument, size_t us_Size, bool b_Block) noexcept
+{
+    size_t us_Position = us_Push.load(std::memory_order_relaxed);
+    Record* p_Current;
+    
+    // Claim a record
+    while (true)
+    {
+        p_Current = &(p_Record[us_Position & (us_RecordCount - 1)]);
+        
+        size_t us_Sequence = p_Current->us_Sequence.load(std::memory_order_acquire);
+        intptr_t i_Diff = (intptr_t)us_Sequence - (intptr_t)us_Position;
+        
+        if (i_Diff == 0)
+        {
+            if (us_Push.compare_exchange_weak(us_Position, us_Position + 1, std::memory_order_relaxed) == true)
+            {
+                break;
+            }
+        }
+        else if (i_Diff < 0)
+        {
+            // Full, the record was not popped yet
+            if (b_Block == false)
+            {
+                return false;
+            }
+            
+            std::this_thread::yield();
+            us_Position = us_Push.load(std::memory_order_relaxed);
+        }
+        else
+        {
+            us_Position = us_Push.load(std::memory_order_relaxed);
+        }
+    }
+    
+    p_Current->u32_Site = u32_Site;
+    p_Current->i_Level = i_Level;
+    p_Current->u64_Time = u64_Time;
+    p_Current->us_Size = us_Size < us_ArgumentSize ? us_Size : us_ArgumentSize;
+    
+    memcpy(p_Current->p_Argument, p_Argument, p_Current->us_Size);
+    
+    // Publish to the consumer
+    p_Current->us_Sequence.store(us_Position + 1, std::memory_order_release);
+    return true;
+}
+
+//*************************************************************************************
+// Pop
+//*************************************************************************************
+
+LogQueue::Record const* LogQueue::Front() noexcept
+{
+    size_t us_Position = us_Pop.load(std::memory_order_relaxed);
+    Record* p_Current = &(p_Record[us_Position & (us_RecordCount - 1)]);
+    
+    if (p_Current->us_Sequence.load(std::memory_order_acquire) != us_Position + 1)
+    {
+        return NULL;
+    }
+    
+    return p_Current;
+}
+
+void LogQueue::Pop() noexcept
+{
+    size_t us_Position = us_Pop.load(std::memory_order_relaxed);
+    Record* p_Current = &(p_Record[us_Position & (us_RecordCount - 1)]);
+    
+    // Free for the push one round later
+    p_Current->us_Sequence.store(us_Position + us_RecordCount, std::memory_order_release);
+    us_Pop.store(us_Position + 1, std::memory_order_release);
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t LogQueue::GetPushPosition() const noexcept
+{
+    return us_Push.load(std::memory_order_acquire);
+}
+
+size_t LogQueue::GetPopPosition() const noexcept
+{
+    return us_Pop.load(std::memory_order_acquire);
+}
@@ -0,0 +1,155 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef LogQueue_h
+#define LogQueue_h
+
+// C / C++
+#include <atomic>
+#include <cstdint>
+
+// External
+
+// Project
+
+
+class LogQueue
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    static constexpr size_t us_RecordCount = 1024; // Power of two
+    static constexpr size_t us_ArgumentSize = 448;
+    
+    struct Record
+    {
+    public:
+        
+        std::atomic<size_t> us_Sequence;
+        
+        uint32_t u32_Site;
+        int i_Level;
+        uint64_t u64_Time;
+        
+        // Encoded with LogArgument
+        size_t us_Size;
+        uint8_t p_Argument[us_ArgumentSize];
+    };
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    LogQueue() noexcept;
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_LogQueue LogQueue class source.
+     */
+    
+    LogQueue(LogQueue const& c_LogQueue) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~LogQueue() noexcept;
+    
+    //*************************************************************************************
+    // Push
+    //*************************************************************************************
+    
+    /**
+     *  Add a record to the queue. This function is thread safe and lock free.
+     *
+     *  \param u32_Site The record call site id.
+     *  \param i_Level The record log level.
+     *  \param u64_Time The record time.
+     *  \param p_Argument The encoded record arguments.
+     *  \param us_Size The encoded arguments size, truncated to fit.
+     *  \param b_Block Wait for a free record if the queue is full.
+     *
+     *  \return true if the record was added, false if the queue was full.
+     */
+    
+    bool Push(uint32_t u32_Site, int i_Level, uint64_t u64_Time, uint8_t const* p_Argument, size_t us_Size, bool b_Block) noexcept;
+    
+    //*************************************************************************************
+    // Pop
+    //*************************************************************************************
+    
+    /**
+     *  Get the oldest record in the queue. Only a single thread may pop
+     *  records.
+     *
+     *  \return The oldest record or NULL if the queue is empty.
+     */
+    
+    Record const* Front() noexcept;
+    
+    /**
+     *  Release the record returned by Front().
+     */
+    
+    void Pop() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the position of the next record to be pushed. This function is
+     *  thread safe.
+     *
+     *  \return The push position.
+     */
+    
+    size_t GetPushPosition() const noexcept;
+    
+    /**
+     *  Get the position of the next record to be popped. This function is
+     *  thread safe.
+     *
+     *  \return The pop position.
+     */
+    
+    size_t GetPopPosition() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    Record p_Record[us_RecordCount];
+    
+    // Producers and consumer on separate cache lines
+    alignas(64) std::atomic<size_t> us_Push;
+    alignas(64) std::atomic<size_t> us_Pop;
+    
+protected:
+    
+};
+
+#endif /* LogQueue_h */
@@ -0,0 +1,144 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstring>
+#include <thread>
+
+// External
+
+// Project
+#include "./LogSiteTable.h"
+
+// Pre-defined
+namespace
+{
+    // Marks a site which is being filled
+    constexpr uint64_t u64_KeyBusy = 2;
+    
+    uint64_t GetKey(const char* p_File, size_t us_Line, const char* p_Format) noexcept
+    {
+        // FNV-1a over file, line and format, always odd so that it never
+        // matches an unused or busy site
+        uint64_t u64_Hash = 14695981039346656037ULL;
+        
+        for (const char* p = p_File; *p != '\0'; ++p)
+        {
+            u64_Hash = (u64_Hash ^ (unsigned char)*p) * 1099511628211ULL;
+        }
+        
+        u64_Hash = (u64_Hash ^ us_Line) * 1099511628211ULL;
+        
+        for (const char* p = p_Format; *p != '\0'; ++p)
+        {
+            u64_Hash = (u64_Hash ^ (unsigned char)*p) * 1099511628211ULL;
+        }
+        
+        return u64_Hash | 1;
+    }
+    
+    bool CopyString(char* p_Dest, size_t us_DestSize, const char* p_Source) noexcept
+    {
+        strncpy(p_Dest, p_Source, us_DestSize - 1);
+        p_Dest[us_DestSize - 1] = '\0';
+        
+        // Truncated if the source did not end in the copied part
+        return strlen(p_Source) >= us_DestSize;
+    }
+    
+    uint32_t GetStaticId(uint64_t u64_Key) noexcept
+    {
+        // The key is only built from the call site, odd to never match 
+        // the fallback site
+        return (uint32_t)(u64_Key ^ (u64_Key >> 32)) | 1;
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+LogSiteTable::LogSiteTable() noexcept
+{
+    for (size_t i = 0; i < us_SiteCount; ++i)
+    {
+        p_Site[i].u64_Key.store(0, std::memory_order_relaxed);
+        p_Site[i].us_Line = 0;
+        p_Site[i].u32_StaticId = u32_FallbackStaticId;
+        p_Site[i].b_Truncated = false;
+        p_Site[i].p_File[0] = '\0';
+        p_Site[i].p_Format[0] = '\0';
+        p_Site[i].b_Written = false;
+    }
+    
+    // The fallback site is never returned for a lookup
+    Site& c_Fallback = p_Site[u32_FallbackSite];
+    
+    CopyString(c_Fallback.p_File, us_FileSize, "?");
+    CopyString(c_Fallback.p_Format, us_FormatSize, "{}");
+    c_Fallback.u64_Key.store(u64_KeyBusy, std::memory_order_release);
+}
+
+LogSiteTable::~LogSiteTable() noexcept
+{}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+uint32_t LogSiteTable::GetId(const char* p_File, size_t us_Line, const char* p_Format) noexcept
+{
+    uint64_t u64_Key = GetKey(p_File, us_Line, p_Format);
+    
+    for (size_t i = 0; i < us_MaxProbe; ++i)
+    {
+        size_t us_Id = (u64_Key + i) & (us_SiteCount - 1);
+        Site& c_Site = p_Site[us_Id];
+        uint64_t u64_Current = c_Site.u64_Key.load(std::memory_order_acquire);
+        
+        // Claim unused sites, fill and then publish
+        if (u64_Current == 0 && c_Site.u64_Key.compare_exchange_strong(u64_Current, u64_KeyBusy) == true)
+        {
+            c_Site.us_Line = us_Line;
+            c_Site.u32_StaticId = GetStaticId(u64_Key);
+            CopyString(c_Site.p_File, us_FileSize, p_File);
+            c_Site.b_Truncated = CopyString(c_Site.p_Format, us_FormatSize, p_Format);
+            
+            c_Site.u64_Key.store(u64_Key, std::memory_order_release);
+            return (uint32_t)us_Id;
+        }
+        
+        // Another thread is adding the same site right now
+        while (u64_Current == u64_KeyBusy && us_Id != u32_FallbackSite)
+        {
+            std::this_thread::yield();
+            u64_Current = c_Site.u64_Key.load(std::memory_order_acquire);
+        }
+        
+        if (u64_Current == u64_Key)
+        {
+            return (uint32_t)us_Id;
+        }
+    }
+    
+    return u32_FallbackSite;
+}
+
+LogSiteTable::Site& LogSiteTable::GetSite(uint32_t u32_Id) noexcept
+{
+    return p_Site[u32_Id & (us_SiteCount - 1)];
+}
@@ -0,0 +1,133 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef LogSiteTable_h
+#define LogSiteTable_h
+
+// C / C++
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+
+// External
+
+// Project
+
+
+class LogSiteTable
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    static constexpr size_t us_SiteCount = 1024; // Power of two
+    static constexpr size_t us_FileSize = 32;
+    static constexpr size_t us_FormatSize = 128;
+    
+    // Used if the table is full, the format is a single string argument
+    static constexpr uint32_t u32_FallbackSite = 0;
+    static constexpr uint32_t u32_FallbackStaticId = 0;
+    
+    struct Site
+    {
+    public:
+        
+        std::atomic<uint64_t> u64_Key; // 0 for unused
+        
+        size_t us_Line;
+        
+        // Hash of file, line and format, the same in every run and never 
+        // u32_FallbackStaticId
+        uint32_t u32_StaticId;
+        
+        // Truncated to fit
+        char p_File[us_FileSize];
+        char p_Format[us_FormatSize];
+        bool b_Truncated; // Format only
+        
+        // Set by the writer once the site was added to the side table
+        bool b_Written;
+    };
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    LogSiteTable() noexcept;
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_LogSiteTable LogSiteTable class source.
+     */
+    
+    LogSiteTable(LogSiteTable const& c_LogSiteTable) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~LogSiteTable() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the id for a call site, the call site is added on first use. The 
+     *  id is a table slot and changes between runs, persisted logs use the 
+     *  site static id instead. This function is thread safe and lock free.
+     *
+     *  \param p_File The call site source file.
+     *  \param us_Line The call site source line.
+     *  \param p_Format The call site message format.
+     *
+     *  \return The call site id, u32_FallbackSite if the table is full.
+     */
+    
+    uint32_t GetId(const char* p_File, size_t us_Line, const char* p_Format) noexcept;
+    
+    /**
+     *  Get a call site by id.
+     *
+     *  \param u32_Id The call site id.
+     *
+     *  \return The call site.
+     */
+    
+    Site& GetSite(uint32_t u32_Id) noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    static constexpr size_t us_MaxProbe = 16;
+    
+    Site p_Site[us_SiteCount];
+    
+protected:
+    
+};
+
+#endif /* LogSiteTable_h */
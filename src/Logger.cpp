@@ -19,7 +19,12 @@
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
+#include <fcntl.h>
+#include <csignal>
+#include <cstring>
+#include <cerrno>
 #include <iostream>
+#include <chrono>
 #include <ctime>
 
 // External
@@ -37,16 +42,124 @@
 #ifndef MRANGEUI_LOGGER_PRINT_CLI
     #define MRANGEUI_LOGGER_PRINT_CLI 0
 #endif
+#ifndef MRANGEUI_LOGGER_ASYNC
+    #define MRANGEUI_LOGGER_ASYNC 1
+#endif
+#ifndef MRANGEUI_LOGGER_BLOCK_ON_FULL
+    #define MRANGEUI_LOGGER_BLOCK_ON_FULL 0
+#endif
+#ifndef MRANGEUI_LOGGER_RATE_BURST
+    #define MRANGEUI_LOGGER_RATE_BURST 10
+#endif
+#ifndef MRANGEUI_LOGGER_RATE_PER_SECOND
+    #define MRANGEUI_LOGGER_RATE_PER_SECOND 1
+#endif
+#ifndef MRANGEUI_LOGGER_BINARY
+    #define MRANGEUI_LOGGER_BINARY 0
+#endif
+#ifndef MRANGEUI_LOG_TABLE_FILE_PATH
+    #define MRANGEUI_LOG_TABLE_FILE_PATH "/var/log/mrh/mrangeui.logtable"
+#endif
+
+namespace
+{
+    // Writer timing
+    constexpr std::chrono::milliseconds c_WriterIdle(100);
+    constexpr std::chrono::milliseconds c_FlushTimeout(1000);
+    
+    // Suppressed messages are summarized once a call site was quiet for 
+    // this long, it would have been allowed to log again by then
+    constexpr std::chrono::milliseconds c_SuppressedIdle(1000);
+    
+    const char* p_RepeatedFormat = "Previous message repeated {} times";
+    
+    // Batches are written once they reach this size
+    constexpr size_t us_BatchSize = 64 * 1024;
+    
+    // Synchronous faults on the writer still reach the crash handler
+    const int p_CrashSignal[] =
+    {
+        SIGILL,
+        SIGTRAP,
+        SIGFPE,
+        SIGABRT,
+        SIGSEGV,
+        SIGBUS
+    };
+    
+    // Binary log file header
+    const char p_BinaryMagic[4] = { 'M', 'R', 'L', 'B' };
+    constexpr uint32_t u32_BinaryVersion = 2;
+    
+    uint64_t GetTime() noexcept
+    {
+        struct timespec c_Time;
+        clock_gettime(CLOCK_REALTIME, &c_Time);
+        
+        return ((uint64_t)c_Time.tv_sec * 1000000000ULL) + (uint64_t)c_Time.tv_nsec;
+    }
+    
+    void WriteSignalSafe(int i_FD, const char* p_String) noexcept
+    {
+        size_t us_Size = strlen(p_String);
+        
+        while (us_Size > 0)
+        {
+            ssize_t ss_Written = write(i_FD, p_String, us_Size);
+            
+            if (ss_Written < 0 && errno == EINTR)
+            {
+                continue;
+            }
+            else if (ss_Written <= 0)
+            {
+                return;
+            }
+            
+            p_String += ss_Written;
+            us_Size -= (size_t)ss_Written;
+        }
+    }
+    
+    template<typename T>
+    void AppendBinary(std::string& s_Batch, T Value) noexcept
+    {
+        s_Batch.append((const char*)&Value, sizeof(T));
+    }
+}
 
 
 //*************************************************************************************
 // Constructor / Destructor
 //*************************************************************************************
 
-Logger::Logger() noexcept
+Logger::Logger() noexcept : i_Level(MRANGEUI_LOGGER_MIN_LEVEL),
+                            c_Limiter(MRANGEUI_LOGGER_RATE_BURST, MRANGEUI_LOGGER_RATE_PER_SECOND),
+                            b_Async(false),
+                            b_Waiting(false),
+                            b_Stop(false),
+                            us_Written(0),
+                            us_Dropped(0),
+                            i_BacktraceFD(-1)
 {
-    f_LogFile.open(MRANGEUI_LOG_FILE_PATH, std::ios::out | std::ios::trunc);
-    f_BacktraceFile.open(MRANGEUI_BACKTRACE_FILE_PATH, std::ios::out | std::ios::trunc);
+    f_LogFile.open(MRANGEUI_LOG_FILE_PATH, std::ios::out | std::ios::trunc | std::ios::binary);
+    
+    // The crash path can only use descriptors which are already open
+    i_BacktraceFD = open(MRANGEUI_BACKTRACE_FILE_PATH, O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+    c_Crashed.clear();
+    
+    // The first backtrace call loads libgcc, which allocates
+    backtrace(p_Trace, 1);
+    
+    // Binary logs start with a header, call sites are stored in a side table
+    if (MRANGEUI_LOGGER_BINARY > 0 && f_LogFile.is_open() == true)
+    {
+        f_LogFile.write(p_BinaryMagic, sizeof(p_BinaryMagic));
+        f_LogFile.write((const char*)&u32_BinaryVersion, sizeof(u32_BinaryVersion));
+        f_LogFile.flush();
+        
+        f_TableFile.open(MRANGEUI_LOG_TABLE_FILE_PATH, std::ios::out | std::ios::trunc);
+    }
     
     if (f_LogFile.is_open() == false)
     {
@@ -54,23 +167,69 @@ Logger::Logger() noexcept
             "Logger.cpp", __LINE__);
     }
     
-    if (f_BacktraceFile.is_open() == false)
+    if (i_BacktraceFD < 0)
     {
-        Log(Logger::WARNING, "Failed to open backtrace file: " MRANGEUI_LOG_FILE_PATH,
+        Log(Logger::WARNING, "Failed to open backtrace file: " MRANGEUI_BACKTRACE_FILE_PATH,
             "Logger.cpp", __LINE__);
     }
+    
+    if (MRANGEUI_LOGGER_ASYNC > 0)
+    {
+        // The logger is created before signals are blocked, the writer 
+        // has to ignore all signals meant for other threads
+        sigset_t c_All;
+        sigset_t c_Previous;
+        sigfillset(&c_All);
+        
+        for (int i_Signal : p_CrashSignal)
+        {
+            sigdelset(&c_All, i_Signal);
+        }
+        
+        pthread_sigmask(SIG_SETMASK, &c_All, &c_Previous);
+        
+        try
+        {
+            c_Writer = std::thread(&Logger::Run, this);
+            b_Async = true;
+        }
+        catch (...)
+        {
+            Log(Logger::WARNING, "Failed to start log writer, logging synchronously!",
+                "Logger.cpp", __LINE__);
+        }
+        
+        pthread_sigmask(SIG_SETMASK, &c_Previous, NULL);
+    }
 }
 
 Logger::~Logger() noexcept
 {
+    if (c_Writer.joinable() == true)
+    {
+        // The writer drains the queue before stopping
+        b_Stop.store(true);
+        c_Wake.notify_one();
+        c_Writer.join();
+    }
+    else
+    {
+        Flush();
+    }
+    
     if (f_LogFile.is_open() == true)
     {
         f_LogFile.close();
     }
     
-    if (f_BacktraceFile.is_open() == true)
+    if (i_BacktraceFD >= 0)
+    {
+        close(i_BacktraceFD);
+    }
+    
+    if (f_TableFile.is_open() == true)
     {
-        f_BacktraceFile.close();
+        f_TableFile.close();
     }
 }
 
@@ -90,76 +249,410 @@ Logger& Logger::Singleton() noexcept
 
 void Logger::Log(LogLevel e_Level, std::string s_Message, std::string s_File, size_t us_Line) noexcept
 {
+    LogFormat(e_Level, s_File.c_str(), us_Line, "{}", s_Message);
+}
+
+void Logger::Flush() noexcept
+{
+    // No writer thread, summarize suppressed messages here
+    if (b_Async == false)
+    {
+        std::string s_Batch;
+        std::string s_Text;
+        
+        c_Mutex.lock();
+        
+        WriteSuppressed(0, s_Batch, s_Text);
+        
+        if (s_Batch.size() > 0)
+        {
+            WriteBatch(s_Batch, s_Text);
+        }
+        
+        c_Mutex.unlock();
+        return;
+    }
+    
+    // Wait for everything queued up to now, the writer might be stuck
+    // on slow storage so give up after a while
+    size_t us_Target = c_Queue.GetPushPosition();
+    auto c_End = std::chrono::steady_clock::now() + c_FlushTimeout;
+    
+    c_Wake.notify_one();
+    
+    while (us_Written.load() < us_Target && std::chrono::steady_clock::now() < c_End)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+}
+
+//*************************************************************************************
+// Writer
+//*************************************************************************************
+
+void Logger::Submit(LogLevel e_Level, const char* p_File, size_t us_Line, const char* p_Format, uint8_t const* p_Argument, size_t us_Size) noexcept
+{
+    // Limit each call site, a failure on every frame should not
+    // turn into a write storm
+    if (MRANGEUI_LOGGER_RATE_BURST > 0)
+    {
+        size_t us_Suppressed;
+        
+        if (c_Limiter.Allow(p_File, us_Line, us_Suppressed) == false)
+        {
+            // The writer reports the suppressed messages if the call 
+            // site stops logging, the file is gone by then
+            if (us_Suppressed == 1)
+            {
+                uint32_t u32_Summary = c_Sites.GetId(p_File, us_Line, p_RepeatedFormat);
+                
+                if (u32_Summary != LogSiteTable::u32_FallbackSite)
+                {
+                    c_Limiter.SetSummary(p_File, us_Line, u32_Summary, e_Level);
+                }
+            }
+            
+            return;
+        }
+        else if (us_Suppressed > 0)
+        {
+            uint8_t p_Repeated[16];
+            size_t us_Repeated = LogArgument::Encode(p_Repeated, sizeof(p_Repeated), us_Suppressed);
+            
+            Write(e_Level, p_File, us_Line, p_RepeatedFormat, p_Repeated, us_Repeated);
+        }
+    }
+    
+    Write(e_Level, p_File, us_Line, p_Format, p_Argument, us_Size);
+}
+
+void Logger::Write(LogLevel e_Level, const char* p_File, size_t us_Line, const char* p_Format, uint8_t const* p_Argument, size_t us_Size) noexcept
+{
+    uint32_t u32_Site = c_Sites.GetId(p_File, us_Line, p_Format);
+    uint8_t p_Fallback[LogQueue::us_ArgumentSize];
+    
+    // No call site left, keep the formatted message instead
+    if (u32_Site == LogSiteTable::u32_FallbackSite)
+    {
+        std::string s_Message = std::string(p_File) + ":" + std::to_string(us_Line) + ": " + LogArgument::Format(p_Format, p_Argument, us_Size);
+        
+        us_Size = LogArgument::Encode(p_Fallback, sizeof(p_Fallback), s_Message);
+        p_Argument = p_Fallback;
+    }
+    
+    if (b_Async == true)
+    {
+        if (c_Queue.Push(u32_Site, e_Level, GetTime(), p_Argument, us_Size, MRANGEUI_LOGGER_BLOCK_ON_FULL > 0) == false)
+        {
+            us_Dropped.fetch_add(1, std::memory_order_relaxed);
+        }
+        else if (b_Waiting.load() == true)
+        {
+            c_Wake.notify_one();
+        }
+        
+        return;
+    }
+    
+    std::string s_Batch;
+    std::string s_Text;
+    
     c_Mutex.lock();
     
+    WriteRecord(u32_Site, e_Level, GetTime(), p_Argument, us_Size, s_Batch, s_Text);
+    WriteBatch(s_Batch, s_Text);
+    
+    c_Mutex.unlock();
+}
+
+void Logger::Run() noexcept
+{
+    // Alternate stacks are per thread, the crash handler runs on it
+    stack_t c_Stack;
+    c_Stack.ss_sp = p_WriterStack;
+    c_Stack.ss_size = sizeof(p_WriterStack);
+    c_Stack.ss_flags = 0;
+    
+    sigaltstack(&c_Stack, NULL);
+    
+    std::string s_Batch;
+    std::string s_Text;
+    
+    s_Batch.reserve(us_BatchSize);
+    
+    // Summaries are checked about once per idle timeout
+    auto c_NextSuppressed = std::chrono::steady_clock::now();
+    
+    while (true)
+    {
+        // Check before draining so that all records queued before the 
+        // stop request are written
+        bool b_Stopping = b_Stop.load();
+        LogQueue::Record const* p_Record;
+        
+        while ((p_Record = c_Queue.Front()) != NULL)
+        {
+            WriteRecord(p_Record->u32_Site,
+                        p_Record->i_Level,
+                        p_Record->u64_Time,
+                        p_Record->p_Argument,
+                        p_Record->us_Size,
+                        s_Batch,
+                        s_Text);
+            
+            c_Queue.Pop();
+            
+            if (s_Batch.size() >= us_BatchSize)
+            {
+                WriteBatch(s_Batch, s_Text);
+                s_Batch.clear();
+                s_Text.clear();
+            }
+        }
+        
+        // Stopping writes all pending summaries
+        auto c_Now = std::chrono::steady_clock::now();
+        
+        if (b_Stopping == true || c_Now >= c_NextSuppressed)
+        {
+            WriteSuppressed(b_Stopping == true ? 0 : c_SuppressedIdle.count(), s_Batch, s_Text);
+            c_NextSuppressed = c_Now + c_WriterIdle;
+        }
+        
+        size_t us_Dropped = this->us_Dropped.exchange(0, std::memory_order_relaxed);
+        
+        if (us_Dropped > 0)
+        {
+            uint8_t p_Dropped[16];
+            size_t us_Size = LogArgument::Encode(p_Dropped, sizeof(p_Dropped), us_Dropped);
+            
+            WriteRecord(c_Sites.GetId("Logger.cpp", __LINE__, "Dropped {} log messages!"),
+                        WARNING,
+                        GetTime(),
+                        p_Dropped,
+                        us_Size,
+                        s_Batch,
+                        s_Text);
+        }
+        
+        if (s_Batch.size() > 0)
+        {
+            WriteBatch(s_Batch, s_Text);
+            s_Batch.clear();
+            s_Text.clear();
+        }
+        
+        us_Written.store(c_Queue.GetPopPosition());
+        
+        if (b_Stopping == true)
+        {
+            return;
+        }
+        
+        // Sleep until a producer wakes us, the timeout covers wake ups 
+        // sent between the check and the wait
+        std::unique_lock<std::mutex> c_Lock(c_WakeMutex);
+        b_Waiting.store(true);
+        
+        if (c_Queue.Front() == NULL && b_Stop.load() == false)
+        {
+            c_Wake.wait_for(c_Lock, c_WriterIdle);
+        }
+        
+        b_Waiting.store(false);
+    }
+}
+
+void Logger::WriteSuppressed(uint64_t u64_IdleMS, std::string& s_Batch, std::string& s_Text) noexcept
+{
+    if (MRANGEUI_LOGGER_RATE_BURST == 0)
+    {
+        return;
+    }
+    
+    for (size_t i = 0; i < LogLimiter::us_SiteCount; ++i)
+    {
+        uint32_t u32_Summary;
+        int i_Level;
+        size_t us_Suppressed = c_Limiter.TakeIdle(i, u64_IdleMS, u32_Summary, i_Level);
+        
+        if (us_Suppressed == 0)
+        {
+            continue;
+        }
+        
+        uint8_t p_Repeated[16];
+        size_t us_Size = LogArgument::Encode(p_Repeated, sizeof(p_Repeated), us_Suppressed);
+        
+        WriteRecord(u32_Summary,
+                    i_Level,
+                    GetTime(),
+                    p_Repeated,
+                    us_Size,
+                    s_Batch,
+                    s_Text);
+    }
+}
+
+void Logger::WriteRecord(uint32_t u32_Site, int i_Level, uint64_t u64_Time, uint8_t const* p_Argument, size_t us_Size, std::string& s_Batch, std::string& s_Text) noexcept
+{
+    LogSiteTable::Site& c_Site = c_Sites.GetSite(u32_Site);
+    
+    // Text is only created if needed
+    if (MRANGEUI_LOGGER_BINARY == 0 || MRANGEUI_LOGGER_PRINT_CLI > 0)
+    {
+        std::string& s_Target = (MRANGEUI_LOGGER_BINARY > 0 ? s_Text : s_Batch);
+        
+        s_Target += "[";
+        s_Target += c_Site.p_File;
+        s_Target += "][";
+        s_Target += std::to_string(c_Site.us_Line);
+        s_Target += "][";
+        s_Target += GetLevelString((LogLevel)i_Level);
+        s_Target += "]: ";
+        s_Target += LogArgument::Format(c_Site.p_Format, p_Argument, us_Size);
+        s_Target += "\n";
+    }
+    
+    if (MRANGEUI_LOGGER_BINARY == 0)
+    {
+        return;
+    }
+    
+    // New call sites are added to the side table before any record uses them
+    if (c_Site.b_Written == false)
+    {
+        if (f_TableFile.is_open() == true)
+        {
+            std::string s_Format = c_Site.p_Format;
+            
+            for (char& c_Character : s_Format)
+            {
+                if (c_Character == '\t' || c_Character == '\n')
+                {
+                    c_Character = ' ';
+                }
+            }
+            
+            // Static id, file, line, truncation flag and format
+            f_TableFile << c_Site.u32_StaticId << '\t' 
+                        << c_Site.p_File << '\t' 
+                        << c_Site.us_Line << '\t' 
+                        << (c_Site.b_Truncated == true ? 1 : 0) << '\t' 
+                        << s_Format << '\n';
+            f_TableFile.flush();
+        }
+        
+        c_Site.b_Written = true;
+    }
+    
+    // Record: static site id, level, time, argument size, arguments
+    AppendBinary(s_Batch, c_Site.u32_StaticId);
+    AppendBinary(s_Batch, (uint8_t)i_Level);
+    AppendBinary(s_Batch, u64_Time);
+    AppendBinary(s_Batch, (uint16_t)us_Size);
+    
+    s_Batch.append((const char*)p_Argument, us_Size);
+}
+
+void Logger::WriteBatch(std::string const& s_Batch, std::string const& s_Text) noexcept
+{
     if (f_LogFile.is_open() == true)
     {
-        f_LogFile << "[" << s_File << "][" << std::to_string(us_Line) << "][" << GetLevelString(e_Level) << "]: " << s_Message << std::endl;
+        f_LogFile.write(s_Batch.data(), s_Batch.size());
+        f_LogFile.flush();
     }
     
     if (MRANGEUI_LOGGER_PRINT_CLI > 0)
     {
-        std::cout << "[" << s_File << "][" << std::to_string(us_Line) << "][" << GetLevelString(e_Level) << "]: " << s_Message << std::endl;
+        std::cout << (MRANGEUI_LOGGER_BINARY > 0 ? s_Text : s_Batch) << std::flush;
     }
-    
-    c_Mutex.unlock();
 }
 
 //*************************************************************************************
 // Backtrace
 //*************************************************************************************
 
-void Logger::Backtrace(size_t us_TraceSize, std::string s_Message) noexcept
+void Logger::Backtrace(int i_Signal) noexcept
 {
-    if (f_BacktraceFile.is_open() == false)
+    // Threads crashing at the same time only get the first report
+    if (c_Crashed.test_and_set() == true)
     {
         return;
     }
     
-    // Retrieve current stack addresses
-    char** p_Traceback = NULL;
-    void* p_AdressList[us_TraceSize];
+    // Write messages leading up to the crash first
+    FlushSignalSafe();
     
-    us_TraceSize = backtrace(p_AdressList, (int)(sizeof(p_AdressList) / sizeof(void*)));
+    int i_TraceSize = backtrace(p_Trace, (int)us_TraceSize);
     
-    // Get names
-    if (us_TraceSize > 0)
+    if (i_BacktraceFD >= 0)
     {
-        p_Traceback = backtrace_symbols(p_AdressList, (int)us_TraceSize);
+        WriteBacktrace(i_BacktraceFD, i_Signal, i_TraceSize);
     }
     
-    // File head
-    WriteBacktrace(f_BacktraceFile, "====================================");
-    WriteBacktrace(f_BacktraceFile, "= " + s_Message);
-    WriteBacktrace(f_BacktraceFile, "====================================");
-    
-    // Print traceback stack
-    if (us_TraceSize == 0)
+    if (MRANGEUI_LOGGER_PRINT_CLI > 0)
     {
-        WriteBacktrace(f_BacktraceFile, "Failed to get traceback!");
+        WriteBacktrace(STDOUT_FILENO, i_Signal, i_TraceSize);
     }
-    else
+}
+
+void Logger::FlushSignalSafe() noexcept
+{
+    // The writer can't drain the queue if it crashed itself
+    if (b_Async == false || pthread_equal(pthread_self(), c_Writer.native_handle()) != 0)
     {
-        for (int i = 0; i < us_TraceSize && p_Traceback[i] != NULL; ++i)
-        {
-            WriteBacktrace(f_BacktraceFile, std::string(p_Traceback[i]));
-        }
+        return;
+    }
+    
+    // No wake up, the writer checks the queue on its idle timeout
+    size_t us_Target = c_Queue.GetPushPosition();
+    struct timespec c_Sleep = { 0, 1000000 };
+    
+    for (auto i = c_FlushTimeout.count(); i > 0 && us_Written.load() < us_Target; --i)
+    {
+        nanosleep(&c_Sleep, NULL);
     }
 }
 
-void Logger::WriteBacktrace(std::ofstream& f_File, std::string s_Message) noexcept
+void Logger::WriteBacktrace(int i_FD, int i_Signal, int i_TraceSize) noexcept
 {
-    if (f_File.is_open() == true)
+    // Signal number as text without formatting functions
+    char p_Signal[16];
+    size_t us_Pos = sizeof(p_Signal) - 1;
+    
+    p_Signal[us_Pos] = '\0';
+    
+    do
     {
-        f_File << s_Message << std::endl;
+        p_Signal[--us_Pos] = '0' + (i_Signal % 10);
+        i_Signal /= 10;
     }
+    while (i_Signal > 0 && us_Pos > 0);
     
-    if (MRANGEUI_LOGGER_PRINT_CLI > 0)
+    WriteSignalSafe(i_FD, "====================================\n= Caught Signal: ");
+    WriteSignalSafe(i_FD, &(p_Signal[us_Pos]));
+    WriteSignalSafe(i_FD, "\n====================================\n");
+    
+    if (i_TraceSize <= 0)
+    {
+        WriteSignalSafe(i_FD, "Failed to get traceback!\n");
+    }
+    else
     {
-        std::cout << s_Message << std::endl;
+        backtrace_symbols_fd(p_Trace, i_TraceSize, i_FD);
     }
 }
 
+//*************************************************************************************
+// Setters
+//*************************************************************************************
+
+void Logger::SetLevel(LogLevel e_Level) noexcept
+{
+    i_Level.store(e_Level, std::memory_order_relaxed);
+}
+
 //*************************************************************************************
 // Getters
 //*************************************************************************************
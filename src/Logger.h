@@ -19,13 +19,24 @@
 
 // C / C++
 #include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
 #include <fstream>
 #include <string>
 
 // External
 
 // Project
+#include "./LogQueue.h"
+#include "./LogLimiter.h"
+#include "./LogSiteTable.h"
+#include "./LogArgument.h"
 
+// Pre-defined
+#ifndef MRANGEUI_LOGGER_MIN_LEVEL
+    #define MRANGEUI_LOGGER_MIN_LEVEL 0 // Calls below this level are not compiled
+#endif
 
 class Logger
 {
@@ -64,7 +75,10 @@ public:
     //*************************************************************************************
     
     /**
-     *  Log a message. This function is thread safe.
+     *  Log a message. This function is thread safe. Messages from the same 
+     *  call site are rate limited, suppressed messages are summarized with 
+     *  the next logged message or once the call site stopped logging. In 
+     *  asynchronous mode the message is queued for the writer thread.
      *
      *  \param e_Level The log level of this message.
      *  \param s_Message The message to log.
@@ -74,18 +88,134 @@ public:
     
     void Log(LogLevel e_Level, std::string s_Message, std::string s_File, size_t us_Line) noexcept;
     
+    /**
+     *  Log a formatted message. Each {} in the format is replaced by the next 
+     *  argument. Arguments are stored as raw values and only formatted when 
+     *  written as text. This function is thread safe.
+     *
+     *  \param e_Level The log level of this message.
+     *  \param p_File The source file this log was created from.
+     *  \param us_Line The source file line this log was created from.
+     *  \param p_Format The message format.
+     *  \param c_Argument The format arguments.
+     */
+    
+    template<typename... Arguments>
+    void LogFormat(LogLevel e_Level, const char* p_File, size_t us_Line, const char* p_Format, Arguments const&... c_Argument) noexcept
+    {
+        if (GetEnabled(e_Level) == false)
+        {
+            return;
+        }
+        
+        uint8_t p_Buffer[LogQueue::us_ArgumentSize];
+        size_t us_Size = Encode(p_Buffer, sizeof(p_Buffer), c_Argument...);
+        
+        Submit(e_Level, p_File, us_Line, p_Format, p_Buffer, us_Size);
+    }
+    
+    /**
+     *  Log a formatted message without rate limiting. Meant for output 
+     *  requested by the operator, like summaries written in a loop from a 
+     *  single call site. This function is thread safe.
+     *
+     *  \param e_Level The log level of this message.
+     *  \param p_File The source file this log was created from.
+     *  \param us_Line The source file line this log was created from.
+     *  \param p_Format The message format.
+     *  \param c_Argument The format arguments.
+     */
+    
+    template<typename... Arguments>
+    void LogFormatUnlimited(LogLevel e_Level, const char* p_File, size_t us_Line, const char* p_Format, Arguments const&... c_Argument) noexcept
+    {
+        if (GetEnabled(e_Level) == false)
+        {
+            return;
+        }
+        
+        uint8_t p_Buffer[LogQueue::us_ArgumentSize];
+        size_t us_Size = Encode(p_Buffer, sizeof(p_Buffer), c_Argument...);
+        
+        Write(e_Level, p_File, us_Line, p_Format, p_Buffer, us_Size);
+    }
+    
+    /**
+     *  Wait until all queued messages are written. Without a writer thread 
+     *  all pending suppressed message summaries are written instead. This 
+     *  function is thread safe.
+     */
+    
+    void Flush() noexcept;
+    
     //*************************************************************************************
     // Backtrace
     //*************************************************************************************
     
     /**
-     *  Write the program backtrace.
+     *  Wait for queued messages and write the program backtrace. This 
+     *  function is async-signal-safe and meant to be called from a crash 
+     *  signal handler, only the first call writes a backtrace.
+     *
+     *  \param i_Signal The signal which caused the crash.
+     */
+    
+    void Backtrace(int i_Signal) noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Check if messages of a log level are logged. This function is thread 
+     *  safe.
      *
-     *  \param us_TraceSize The size of the backtrace.
-     *  \param s_Message The message describing the backtrace cause.
+     *  \param e_Level The log level to check.
+     *
+     *  \return true if the level is logged, false if not.
      */
     
-    void Backtrace(size_t us_TraceSize, std::string s_Message) noexcept;
+    bool GetEnabled(LogLevel e_Level) const noexcept
+    {
+        return e_Level >= i_Level.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     *  Get the file name of a source file path. This function is thread safe.
+     *
+     *  \param p_Path The source file path.
+     *
+     *  \return The file name part of the path.
+     */
+    
+    static constexpr const char* GetFileName(const char* p_Path) noexcept
+    {
+        const char* p_Name = p_Path;
+        
+        for (; *p_Path != '\0'; ++p_Path)
+        {
+            if (*p_Path == '/')
+            {
+                p_Name = p_Path + 1;
+            }
+        }
+        
+        return p_Name;
+    }
+    
+    //*************************************************************************************
+    // Setters
+    //*************************************************************************************
+    
+    /**
+     *  Set the minimum log level to log. Messages below this level are 
+     *  discarded before their arguments are formatted. This function is 
+     *  thread safe.
+     *
+     *  \param e_Level The minimum log level.
+     */
+    
+    void SetLevel(LogLevel e_Level) noexcept;
     
 private:
     
@@ -105,18 +235,119 @@ private:
     
     ~Logger() noexcept;
     
+    //*************************************************************************************
+    // Writer
+    //*************************************************************************************
+    
+    /**
+     *  Encode format arguments in order, arguments which don't fit are left 
+     *  out.
+     *
+     *  \param p_Buffer The buffer to encode to.
+     *  \param us_Size The buffer size.
+     *  \param c_Argument The format arguments.
+     *
+     *  \return The encoded size.
+     */
+    
+    template<typename... Arguments>
+    static size_t Encode(uint8_t* p_Buffer, size_t us_Size, Arguments const&... c_Argument) noexcept
+    {
+        size_t us_Used = 0;
+        
+        int p_Expand[] = { 0, ((us_Used += LogArgument::Encode(p_Buffer + us_Used, us_Size - us_Used, c_Argument)), 0)... };
+        (void)p_Expand;
+        
+        return us_Used;
+    }
+    
+    /**
+     *  Rate limit and write or queue an encoded message.
+     *
+     *  \param e_Level The log level of this message.
+     *  \param p_File The source file this log was created from.
+     *  \param us_Line The source file line this log was created from.
+     *  \param p_Format The message format.
+     *  \param p_Argument The encoded format arguments.
+     *  \param us_Size The encoded format arguments size.
+     */
+    
+    void Submit(LogLevel e_Level, const char* p_File, size_t us_Line, const char* p_Format, uint8_t const* p_Argument, size_t us_Size) noexcept;
+    
+    /**
+     *  Write or queue an encoded message without rate limiting.
+     *
+     *  \param e_Level The log level of this message.
+     *  \param p_File The source file this log was created from.
+     *  \param us_Line The source file line this log was created from.
+     *  \param p_Format The message format.
+     *  \param p_Argument The encoded format arguments.
+     *  \param us_Size The encoded format arguments size.
+     */
+    
+    void Write(LogLevel e_Level, const char* p_File, size_t us_Line, const char* p_Format, uint8_t const* p_Argument, size_t us_Size) noexcept;
+    
+    /**
+     *  Write queued messages in batches until the logger is destroyed.
+     */
+    
+    void Run() noexcept;
+    
+    /**
+     *  Add the suppressed message summaries of call sites which stopped 
+     *  logging to the output batch.
+     *
+     *  \param u64_IdleMS The time in milliseconds a call site has to be idle.
+     *  \param s_Batch The batch to add to.
+     *  \param s_Text The text batch for the command line in binary mode.
+     */
+    
+    void WriteSuppressed(uint64_t u64_IdleMS, std::string& s_Batch, std::string& s_Text) noexcept;
+    
+    /**
+     *  Add a message to the output batch.
+     *
+     *  \param u32_Site The message call site id.
+     *  \param i_Level The log level of this message.
+     *  \param u64_Time The message time.
+     *  \param p_Argument The encoded format arguments.
+     *  \param us_Size The encoded format arguments size.
+     *  \param s_Batch The batch to add to.
+     *  \param s_Text The text batch for the command line in binary mode.
+     */
+    
+    void WriteRecord(uint32_t u32_Site, int i_Level, uint64_t u64_Time, uint8_t const* p_Argument, size_t us_Size, std::string& s_Batch, std::string& s_Text) noexcept;
+    
+    /**
+     *  Write a batch of messages.
+     *
+     *  \param s_Batch The messages to write to the log file.
+     *  \param s_Text The text batch for the command line in binary mode.
+     */
+    
+    void WriteBatch(std::string const& s_Batch, std::string const& s_Text) noexcept;
+    
     //*************************************************************************************
     // Backtrace
     //*************************************************************************************
     
     /**
-     *  Write a line from the backtrace.
+     *  Wait until the writer thread wrote all queued messages without 
+     *  locking. This function is async-signal-safe.
+     */
+    
+    void FlushSignalSafe() noexcept;
+    
+    /**
+     *  Write the signal header and backtrace to a descriptor. This function 
+     *  is async-signal-safe.
      *
-     *  \param f_File The file to write to.
-     *  \param s_Message The message to write.
+     *  \param i_FD The descriptor to write to.
+     *  \param i_Signal The signal which caused the crash.
+     *  \param i_TraceSize The number of backtrace addresses.
      */
     
-    void WriteBacktrace(std::ofstream& f_File, std::string s_Message) noexcept;
+    void WriteBacktrace(int i_FD, int i_Signal, int i_TraceSize) noexcept;
     
     //*************************************************************************************
     // Getters
@@ -138,11 +369,80 @@ private:
     
     std::mutex c_Mutex;
     
+    std::atomic<int> i_Level;
+    
     std::ofstream f_LogFile;
-    std::ofstream f_BacktraceFile;
+    std::ofstream f_TableFile; // Binary only
+    
+    LogLimiter c_Limiter;
+    LogSiteTable c_Sites;
+    
+    // Asynchronous writer
+    bool b_Async;
+    LogQueue c_Queue;
+    std::thread c_Writer;
+    std::mutex c_WakeMutex;
+    std::condition_variable c_Wake;
+    std::atomic<bool> b_Waiting;
+    std::atomic<bool> b_Stop;
+    std::atomic<size_t> us_Written;
+    std::atomic<size_t> us_Dropped;
+    
+    // Crash handling, preallocated before any crash happens
+    static constexpr size_t us_TraceSize = 64;
+    static constexpr size_t us_WriterStackSize = 64 * 1024;
+    
+    int i_BacktraceFD;
+    void* p_Trace[us_TraceSize];
+    std::atomic_flag c_Crashed;
+    
+    alignas(16) char p_WriterStack[us_WriterStackSize]; // Writer signal stack
     
 protected:
     
 };
 
+//*************************************************************************************
+// Log Macros
+//*************************************************************************************
+
+/**
+ *  Log a formatted message with the calling source file and line. Arguments 
+ *  are only evaluated if the level is logged at runtime. Levels below 
+ *  MRANGEUI_LOGGER_MIN_LEVEL are removed at compile time.
+ *
+ *  \param e_Level The log level of this message.
+ *  \param ... The message format followed by the format arguments.
+ */
+
+#define MRANGEUI_LOG(e_Level, ...) \
+    do \
+    { \
+        static constexpr const char* p_LogFile = Logger::GetFileName(__FILE__); \
+        Logger& c_LogTarget = Logger::Singleton(); \
+        \
+        if (c_LogTarget.GetEnabled(e_Level) == true) \
+        { \
+            c_LogTarget.LogFormat(e_Level, p_LogFile, __LINE__, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#if MRANGEUI_LOGGER_MIN_LEVEL <= 0
+    #define MRANGEUI_LOG_INFO(...) MRANGEUI_LOG(Logger::INFO, __VA_ARGS__)
+#else
+    #define MRANGEUI_LOG_INFO(...) do {} while (0)
+#endif
+
+#if MRANGEUI_LOGGER_MIN_LEVEL <= 1
+    #define MRANGEUI_LOG_WARNING(...) MRANGEUI_LOG(Logger::WARNING, __VA_ARGS__)
+#else
+    #define MRANGEUI_LOG_WARNING(...) do {} while (0)
+#endif
+
+#if MRANGEUI_LOGGER_MIN_LEVEL <= 2
+    #define MRANGEUI_LOG_ERROR(...) MRANGEUI_LOG(Logger::ERROR, __VA_ARGS__)
+#else
+    #define MRANGEUI_LOG_ERROR(...) do {} while (0)
+#endif
+
 #endif /* Logger_h */
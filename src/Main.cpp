@@ -17,7 +17,9 @@
 // C / C++
 #include <csignal>
 #include <cstdlib>
+#include <cstring>
 #include <new>
+#include <memory>
 #include <clocale>
 
 // External
@@ -26,18 +28,43 @@
 
 // Project
 #include "./UI.h"
+#include "./Reactor.h"
+#include "./Configuration.h"
 #include "./Locale.h"
+#include "./Profiler.h"
 #include "./Logger.h"
 #include "./Revision.h"
 
 // Pre-defined
+#ifndef MRANGEUI_SNAPSHOT_DIR
+    #define MRANGEUI_SNAPSHOT_DIR ""
+#endif
+
 namespace
 {
-    // Signal
-    int i_LastSignal = -1;
-    
     // Locale
     std::string s_DefaultLocale = "en_US.UTF-8";
+    locale_t c_Locale = (locale_t)0;
+    
+    // Resize bursts are applied once no new size arrived for this long
+    constexpr Uint32 u32_ResizeDelayMS = 100;
+    
+    // Snapshots are saved on shutdown and rarely in between, each write 
+    // wears the flash storage
+    constexpr Uint32 u32_SnapshotIntervalMS = 4 * 60 * 60 * 1000;
+    
+    // Crash signals, handled on their own stack to survive stack overflows
+    const int p_CrashSignal[] =
+    {
+        SIGILL,
+        SIGTRAP,
+        SIGFPE,
+        SIGABRT,
+        SIGSEGV,
+        SIGBUS
+    };
+    
+    alignas(16) char p_CrashStack[64 * 1024];
 }
 
 
@@ -50,27 +77,45 @@ extern "C"
 {
     void SignalHandler(int i_Signal)
     {
-        switch (i_Signal)
+        // Only async-signal-safe calls from here on
+        Logger::Singleton().Backtrace(i_Signal);
+        
+        // The default action was restored on entry, the raised signal
+        // is delivered on return and creates a core dump
+        raise(i_Signal);
+    }
+}
+
+static bool InstallSignalHandler() noexcept
+{
+    // Only the main thread uses the alternate stack, other threads
+    // still report as long as their own stack is usable
+    stack_t c_Stack;
+    c_Stack.ss_sp = p_CrashStack;
+    c_Stack.ss_size = sizeof(p_CrashStack);
+    c_Stack.ss_flags = 0;
+    
+    if (sigaltstack(&c_Stack, NULL) < 0)
+    {
+        return false;
+    }
+    
+    struct sigaction c_Action;
+    memset(&c_Action, 0, sizeof(c_Action));
+    
+    c_Action.sa_handler = SignalHandler;
+    c_Action.sa_flags = SA_ONSTACK | SA_RESETHAND;
+    sigemptyset(&c_Action.sa_mask);
+    
+    for (int i_Signal : p_CrashSignal)
+    {
+        if (sigaction(i_Signal, &c_Action, NULL) < 0)
         {
-            case SIGILL:
-            case SIGTRAP:
-            case SIGFPE:
-            case SIGABRT:
-            case SIGSEGV:
-                Logger::Singleton().Backtrace(25, "Caught Signal: " + std::to_string(i_Signal));
-                exit(EXIT_FAILURE);
-                break;
-                
-            case SIGTERM:
-            case SIGHUP:
-                i_LastSignal = i_Signal;
-                break;
-                
-            default:
-                i_LastSignal = -1;
-                break;
+            return false;
         }
     }
+    
+    return true;
 }
 
 //*************************************************************************************
@@ -79,9 +124,7 @@ extern "C"
 
 static void SetLocale() noexcept
 {
-    Logger& s_Logger = Logger::Singleton();
-    s_Logger.Log(Logger::INFO, "Updating locale...",
-                 "Main.cpp", __LINE__);
+    MRANGEUI_LOG_INFO("Updating locale...");
     
     std::string s_Locale;
     
@@ -92,94 +135,327 @@ static void SetLocale() noexcept
     }
     catch (Exception& e)
     {
-        s_Logger.Log(Logger::WARNING, "Failed to read locale file: " +
-                                      e.what2(),
-                     "Main.cpp", __LINE__);
+        MRANGEUI_LOG_WARNING("Failed to read locale file: {}", e.what2());
         s_Locale = s_DefaultLocale;
     }
     
-    std::setlocale(LC_ALL, s_Locale.c_str());
+    // setlocale() races with the logger and decoder threads, only the 
+    // render thread formats with the locale and gets its own
+    c_Locale = newlocale(LC_ALL_MASK, s_Locale.c_str(), (locale_t)0);
     
-    if (s_Locale.compare(std::setlocale(LC_ALL, NULL)) != 0)
+    if (c_Locale == (locale_t)0)
     {
-        s_Logger.Log(Logger::WARNING, "Failed to set locale to " + s_Locale + "!",
-                     "Main.cpp", __LINE__);
-        std::setlocale(LC_ALL, s_DefaultLocale.c_str());
+        MRANGEUI_LOG_WARNING("Failed to set locale to {}!", s_Locale);
+        c_Locale = newlocale(LC_ALL_MASK, s_DefaultLocale.c_str(), (locale_t)0);
     }
     else
     {
-        s_Logger.Log(Logger::INFO, "Locale set to " + s_Locale + "!",
-                     "Main.cpp", __LINE__);
+        MRANGEUI_LOG_INFO("Locale set to {}!", s_Locale);
+    }
+    
+    if (c_Locale != (locale_t)0)
+    {
+        uselocale(c_Locale);
     }
 }
 
+static void ResetLocale() noexcept
+{
+    if (c_Locale == (locale_t)0)
+    {
+        return;
+    }
+    
+    uselocale(LC_GLOBAL_LOCALE);
+    freelocale(c_Locale);
+    
+    c_Locale = (locale_t)0;
+}
+
+//*************************************************************************************
+// Startup
+//*************************************************************************************
+
+static void LogStartup(const char* p_Phase, uint64_t u64_Boot, uint64_t& u64_Start) noexcept
+{
+    uint64_t u64_Now = Profiler::GetTime();
+    
+    // Logged directly, startup times are kept in release builds and 
+    // all phases share this call site
+    Logger::Singleton().LogFormatUnlimited(Logger::INFO, "Main.cpp", __LINE__,
+                                           "Startup {}: {} us (total {} us)",
+                                           p_Phase,
+                                           (u64_Now - u64_Start) / 1000,
+                                           (u64_Now - u64_Boot) / 1000);
+    
+    u64_Start = u64_Now;
+}
+
 //*************************************************************************************
 // Main
 //*************************************************************************************
 
 int main(int argc, char* argv[])
 {
-    // Log Setup
-    Logger& c_Logger = Logger::Singleton();
-    c_Logger.Log(Logger::INFO, "=============================================", "Main.cpp", __LINE__);
-    c_Logger.Log(Logger::INFO, "= Started MRange UI (" + std::string(VERSION_NUMBER) + ")", "Main.cpp", __LINE__);
-    c_Logger.Log(Logger::INFO, "=============================================", "Main.cpp", __LINE__);
-    
-    // Install signal handlers
-    std::signal(SIGTERM, SignalHandler);
-    std::signal(SIGILL, SignalHandler);
-    std::signal(SIGTRAP, SignalHandler);
-    std::signal(SIGFPE, SignalHandler);
-    std::signal(SIGABRT, SignalHandler);
-    std::signal(SIGSEGV, SignalHandler);
-    std::signal(SIGHUP, SignalHandler);
-    
-    // Load configuration
-    SetLocale();
-    
-    // Initialize SDL
-    if (SDL_Init(SDL_INIT_VIDEO) < 0)
-    {
-        c_Logger.Log(Logger::ERROR, "Failed to initialize SDL!", "Main.cpp", __LINE__);
+    // Log Setup, the logger has to exist before the crash handler can use it
+    uint64_t u64_Boot = Profiler::GetTime();
+    uint64_t u64_Phase = u64_Boot;
+    
+    Logger::Singleton();
+    
+    MRANGEUI_LOG_INFO("=============================================");
+    MRANGEUI_LOG_INFO("= Started MRange UI (" VERSION_NUMBER ")");
+    MRANGEUI_LOG_INFO("=============================================");
+    
+    // Install signal handlers, SIGTERM, SIGHUP and SIGUSR2 are recieved by the reactor
+    // and have to be blocked before any thread is started
+    if (Reactor::BlockSignals() == false)
+    {
+        MRANGEUI_LOG_ERROR("Failed to block signals!");
         return EXIT_FAILURE;
     }
-    else if (IMG_Init(IMG_INIT_PNG) < 0)
+    
+    if (InstallSignalHandler() == false)
+    {
+        MRANGEUI_LOG_ERROR("Failed to install crash handler!");
+        return EXIT_FAILURE;
+    }
+    
+    // Load configuration, released on every return
+    std::unique_ptr<Configuration> p_Configuration;
+    
+    try
+    {
+        p_Configuration.reset(new Configuration(argc, argv));
+    }
+    catch (std::exception& e)
     {
-        c_Logger.Log(Logger::ERROR, "Failed to initialize SDL_image!", "Main.cpp", __LINE__);
+        MRANGEUI_LOG_ERROR("Failed to read arguments: {}", e.what());
         return EXIT_FAILURE;
     }
-    else if (TTF_Init() < 0)
+    
+    Logger::Singleton().SetLevel(p_Configuration->GetLogLevel());
+    LogStartup("logger and arguments", u64_Boot, u64_Phase);
+    
+    // Initialize SDL, headless rendering needs no video subsystem
+    if (SDL_Init(p_Configuration->GetHeadless() == true ? (SDL_INIT_EVENTS | SDL_INIT_TIMER) : SDL_INIT_VIDEO) < 0)
     {
-        c_Logger.Log(Logger::ERROR, "Failed to initialize SDL_ttf!", "Main.cpp", __LINE__);
+        MRANGEUI_LOG_ERROR("Failed to initialize SDL!");
         return EXIT_FAILURE;
     }
     
+    LogStartup("SDL", u64_Boot, u64_Phase);
+    
+    int i_Result = EXIT_SUCCESS;
+    
     // Update UI
     try
     {
-        UI c_UI(1920,
-                1080);
-        Clock c_Clock;
+        // The snapshot is presented first, everything else only matters 
+        // once the components are created
+        UI c_UI(p_Configuration->GetWidth(),
+                p_Configuration->GetHeight(),
+                p_Configuration->GetHeadless(),
+                p_Configuration->GetVSync(),
+                p_Configuration->GetSolarRate(),
+                p_Configuration->GetFrameDirectory(),
+                MRANGEUI_SNAPSHOT_DIR);
+        
+        LogStartup("snapshot", u64_Boot, u64_Phase);
+        
+        if (IMG_Init(IMG_INIT_PNG) < 0)
+        {
+            throw Exception("Failed to initialize SDL_image!");
+        }
+        else if (TTF_Init() < 0)
+        {
+            throw Exception("Failed to initialize SDL_ttf!");
+        }
+        
+        LogStartup("SDL_image and SDL_ttf", u64_Boot, u64_Phase);
+        
+        // The locale is needed by the first frame, set it before the components
+        SetLocale();
+        LogStartup("locale", u64_Boot, u64_Phase);
+        
+        c_UI.Initialize();
+        LogStartup("components", u64_Boot, u64_Phase);
+        
+        TimeSource c_TimeSource(p_Configuration->GetTimeMode(),
+                                p_Configuration->GetTimeStart(),
+                                p_Configuration->GetTimeLapse());
+        Clock c_Clock(c_TimeSource);
+        Reactor c_Reactor(c_TimeSource);
+        FramePacer c_Pacer(p_Configuration->GetPacing(),
+                           p_Configuration->GetFrameRate());
+        bool b_Continuous = (c_Pacer.GetMode() == FramePacer::CONTINUOUS);
+        
+        if (b_Continuous == true && p_Configuration->GetVSync() == false && p_Configuration->GetFrameRate() == 0)
+        {
+            MRANGEUI_LOG_WARNING("Continuous pacing without vsync or frame cap, drawing as fast as possible!");
+        }
+        
         SDL_Event c_Event;
+        bool b_Run = true;
+        bool b_Redraw = true;
+        bool b_Present = false;
+        bool b_Resize = false;
+        int i_ResizeW = 0;
+        int i_ResizeH = 0;
+        Uint32 u32_ResizeTime = 0;
+        bool b_FirstFrame = true;
+        Uint32 u32_SnapshotTime = SDL_GetTicks() + u32_SnapshotIntervalMS;
         
-        do
+        while (b_Run == true)
         {
-            // Update clock first
-            c_Clock.Update();
+            // Apply the last size of a resize burst
+            if (b_Resize == true && SDL_TICKS_PASSED(SDL_GetTicks(), u32_ResizeTime))
+            {
+                c_UI.UpdateSize(i_ResizeW, i_ResizeH);
+                
+                b_Resize = false;
+                b_Redraw = true;
+            }
+            
+            // Only draw if something changed, the reactor wakes us on
+            // every minute of the time source. Continuous pacing draws 
+            // and presents every frame.
+            if (b_Redraw == true || b_Continuous == true)
+            {
+                c_Pacer.Wait();
+                c_Clock.Update();
+                
+                if (c_UI.Draw(c_Clock) == true)
+                {
+                    b_Present = false;
+                    
+                    // Frames drawn while assets load are not the real one
+                    if (b_FirstFrame == true && c_UI.GetReady() == true)
+                    {
+                        LogStartup("first frame", u64_Boot, u64_Phase);
+                        b_FirstFrame = false;
+                    }
+                    
+                    if (SDL_TICKS_PASSED(SDL_GetTicks(), u32_SnapshotTime))
+                    {
+                        c_UI.SaveSnapshot();
+                        u32_SnapshotTime = SDL_GetTicks() + u32_SnapshotIntervalMS;
+                    }
+                }
+                else if (b_Continuous == true)
+                {
+                    b_Present = true;
+                }
+                
+                b_Redraw = false;
+            }
+            
+            // Exposed windows only need the last frame again
+            if (b_Present == true)
+            {
+                c_UI.Present();
+                b_Present = false;
+            }
+            
+            // Sleep until the next event, the pending resize or the next 
+            // component update, continuous drawing only takes what is 
+            // already queued
+            int i_Wait = (b_Continuous == true ? -1 : c_UI.GetUpdateDelay());
+            
+            if (b_Resize == true)
+            {
+                Sint32 i_Resize = (Sint32)(u32_ResizeTime - SDL_GetTicks());
+                i_Resize = (i_Resize > 0 ? i_Resize : 0);
+                
+                if (i_Wait < 0 || i_Resize < i_Wait)
+                {
+                    i_Wait = i_Resize;
+                }
+            }
             
-            // Draw the UI
-            c_UI.Draw(c_Clock);
+            if (b_Continuous == true)
+            {
+                if (SDL_PollEvent(&c_Event) == 0)
+                {
+                    continue;
+                }
+            }
+            else if (i_Wait >= 0)
+            {
+                if (SDL_WaitEventTimeout(&c_Event, i_Wait) == 0)
+                {
+                    b_Redraw = true;
+                    continue;
+                }
+            }
+            else if (SDL_WaitEvent(&c_Event) == 0)
+            {
+                MRANGEUI_LOG_ERROR("Failed to wait for events: {}", SDL_GetError());
+                break;
+            }
             
             // Now update all recieved events
-            while (SDL_PollEvent(&c_Event) > 0)
+            do
             {
                 // Close ui?
                 if (c_Event.type == SDL_QUIT)
                 {
-                    i_LastSignal = SIGTERM;
+                    b_Run = false;
                     break;
                 }
                 
+                // Reactor event to handle
+                if (c_Event.type == Reactor::GetEventType())
+                {
+                    switch (c_Event.user.code)
+                    {
+                            /**
+                             *  Minute, Redraw
+                             */
+                            
+                        case Reactor::TIMER:
+                        case Reactor::REDRAW:
+                            b_Redraw = true;
+                            break;
+                            
+                            /**
+                             *  Time Zone
+                             */
+                        
+                        case Reactor::TIME_ZONE:
+                            MRANGEUI_LOG_INFO("Time zone changed.");
+                            c_Clock.Invalidate();
+                            b_Redraw = true;
+                            break;
+                            
+                            /**
+                             *  Signal
+                             */
+                            
+                        case Reactor::SIGNAL:
+                            if ((intptr_t)(c_Event.user.data1) == SIGTERM)
+                            {
+                                b_Run = false;
+                            }
+                            else if ((intptr_t)(c_Event.user.data1) == SIGUSR2)
+                            {
+                                c_UI.LogProfile();
+                            }
+                            else
+                            {
+                                MRANGEUI_LOG_INFO("Caught Signal: {}", (intptr_t)(c_Event.user.data1));
+                            }
+                            break;
+                            
+                            /**
+                             *  Unk
+                             */
+                            
+                        default:
+                            break;
+                    }
+                }
+                
                 // Window event to handle
                 if (c_Event.type == SDL_WINDOWEVENT)
                 {
@@ -191,7 +467,18 @@ int main(int argc, char* argv[])
                             
                         case SDL_WINDOWEVENT_RESIZED:
                         case SDL_WINDOWEVENT_SIZE_CHANGED:
-                            c_UI.UpdateSize(c_Event.window.data1, c_Event.window.data2);
+                            i_ResizeW = c_Event.window.data1;
+                            i_ResizeH = c_Event.window.data2;
+                            u32_ResizeTime = SDL_GetTicks() + u32_ResizeDelayMS;
+                            b_Resize = true;
+                            break;
+                            
+                            /**
+                             *  Expose
+                             */
+                            
+                        case SDL_WINDOWEVENT_EXPOSED:
+                            b_Present = true;
                             break;
                             
                             /**
@@ -203,12 +490,16 @@ int main(int argc, char* argv[])
                     }
                 }
             }
+            while (b_Run == true && SDL_PollEvent(&c_Event) > 0);
         }
-        while (i_LastSignal != SIGTERM);
+        
+        // Keep the last frame for the next start
+        c_UI.SaveSnapshot();
     }
     catch (std::exception& e)
     {
-        c_Logger.Log(Logger::ERROR, e.what(), "Main.cpp", __LINE__);
+        MRANGEUI_LOG_ERROR("{}", e.what());
+        i_Result = EXIT_FAILURE;
     }
     
     // All done, now terminate
@@ -216,6 +507,8 @@ int main(int argc, char* argv[])
     IMG_Quit();
     SDL_Quit();
     
-    c_Logger.Log(Logger::INFO, "Successfully closed MRange UI.", "Main.cpp", __LINE__);
-    return EXIT_SUCCESS;
+    ResetLocale();
+    
+    MRANGEUI_LOG_INFO("Successfully closed MRange UI.");
+    return i_Result;
 }
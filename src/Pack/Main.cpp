@@ -0,0 +1,190 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+#include <fstream>
+#include <iostream>
+
+// External
+#include <SDL2/SDL.h>
+#include <SDL2/SDL_image.h>
+
+// Project
+#include "../AssetPack.h"
+
+// Pre-defined
+namespace
+{
+    // Format used by the accelerated and software renderers
+    constexpr uint32_t u32_PackFormat = SDL_PIXELFORMAT_ARGB8888;
+}
+
+
+//*************************************************************************************
+// Decode
+//*************************************************************************************
+
+static SDL_Surface* Decode(const char* p_FilePath, AssetPack::Entry& c_Entry) noexcept
+{
+    // Entries are named by file name
+    const char* p_Name = strrchr(p_FilePath, '/');
+    p_Name = (p_Name != NULL ? p_Name + 1 : p_FilePath);
+    
+    if (strlen(p_Name) >= sizeof(c_Entry.p_Name))
+    {
+        std::cerr << "Asset name too long: " << p_Name << std::endl;
+        return NULL;
+    }
+    
+    SDL_Surface* p_Loaded = IMG_Load(p_FilePath);
+    
+    if (p_Loaded == NULL)
+    {
+        std::cerr << "Failed to load file: " << p_FilePath << ": " << IMG_GetError() << std::endl;
+        return NULL;
+    }
+    
+    SDL_Surface* p_Surface = SDL_ConvertSurfaceFormat(p_Loaded, u32_PackFormat, 0);
+    SDL_FreeSurface(p_Loaded);
+    
+    if (p_Surface == NULL)
+    {
+        std::cerr << "Failed to convert file: " << p_FilePath << ": " << SDL_GetError() << std::endl;
+        return NULL;
+    }
+    
+    memset(&c_Entry, 0, sizeof(c_Entry));
+    strcpy(c_Entry.p_Name, p_Name);
+    
+    c_Entry.u32_W = (uint32_t)p_Surface->w;
+    c_Entry.u32_H = (uint32_t)p_Surface->h;
+    c_Entry.u32_Pitch = (uint32_t)p_Surface->pitch;
+    c_Entry.u64_Size = (uint64_t)p_Surface->pitch * p_Surface->h;
+    
+    return p_Surface;
+}
+
+//*************************************************************************************
+// Write
+//*************************************************************************************
+
+static uint64_t GetPageOffset(uint64_t u64_Offset) noexcept
+{
+    return ((u64_Offset + AssetPack::u64_PageSize - 1) / AssetPack::u64_PageSize) * AssetPack::u64_PageSize;
+}
+
+static bool WritePadding(std::ofstream& f_File, uint64_t u64_Offset) noexcept
+{
+    static const char p_Zero[AssetPack::u64_PageSize] = { 0 };
+    uint64_t u64_Padding = GetPageOffset(u64_Offset) - u64_Offset;
+    
+    return f_File.write(p_Zero, (std::streamsize)u64_Padding).good();
+}
+
+static bool Write(const char* p_FilePath, std::vector<AssetPack::Entry>& v_Entry, std::vector<SDL_Surface*> const& v_Surface) noexcept
+{
+    std::ofstream f_File(p_FilePath, std::ios::out | std::ios::binary | std::ios::trunc);
+    
+    if (f_File.is_open() == false)
+    {
+        return false;
+    }
+    
+    // Place all entries first, data follows the index page aligned
+    AssetPack::Header c_Header = { AssetPack::u32_Magic,
+                                   AssetPack::u32_Version,
+                                   u32_PackFormat,
+                                   (uint32_t)v_Entry.size() };
+    uint64_t u64_Offset = sizeof(AssetPack::Header) + (v_Entry.size() * sizeof(AssetPack::Entry));
+    
+    for (auto& Entry : v_Entry)
+    {
+        Entry.u64_Offset = GetPageOffset(u64_Offset);
+        u64_Offset = Entry.u64_Offset + Entry.u64_Size;
+    }
+    
+    f_File.write((const char*)&c_Header, sizeof(c_Header));
+    f_File.write((const char*)v_Entry.data(), v_Entry.size() * sizeof(AssetPack::Entry));
+    
+    u64_Offset = sizeof(AssetPack::Header) + (v_Entry.size() * sizeof(AssetPack::Entry));
+    
+    for (size_t i = 0; i < v_Entry.size(); ++i)
+    {
+        if (WritePadding(f_File, u64_Offset) == false ||
+            f_File.write((const char*)(v_Surface[i]->pixels), (std::streamsize)v_Entry[i].u64_Size).good() == false)
+        {
+            return false;
+        }
+        
+        u64_Offset = v_Entry[i].u64_Offset + v_Entry[i].u64_Size;
+    }
+    
+    return f_File.good();
+}
+
+//*************************************************************************************
+// Main
+//*************************************************************************************
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3)
+    {
+        std::cerr << "Usage: " << argv[0] << " <pack file> <image file>..." << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    if (IMG_Init(IMG_INIT_PNG) < 0)
+    {
+        std::cerr << "Failed to initialize SDL_image!" << std::endl;
+        return EXIT_FAILURE;
+    }
+    
+    std::vector<AssetPack::Entry> v_Entry(argc - 2);
+    std::vector<SDL_Surface*> v_Surface;
+    int i_Result = EXIT_SUCCESS;
+    
+    for (int i = 2; i < argc; ++i)
+    {
+        SDL_Surface* p_Surface = Decode(argv[i], v_Entry[i - 2]);
+        
+        if (p_Surface == NULL)
+        {
+            i_Result = EXIT_FAILURE;
+            break;
+        }
+        
+        v_Surface.emplace_back(p_Surface);
+    }
+    
+    if (i_Result == EXIT_SUCCESS && Write(argv[1], v_Entry, v_Surface) == false)
+    {
+        std::cerr << "Failed to write pack file: " << argv[1] << std::endl;
+        i_Result = EXIT_FAILURE;
+    }
+    
+    for (auto& Surface : v_Surface)
+    {
+        SDL_FreeSurface(Surface);
+    }
+    
+    IMG_Quit();
+    
+    return i_Result;
+}
@@ -0,0 +1,87 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <ctime>
+
+// External
+
+// Project
+#include "./Profiler.h"
+#include "./Logger.h"
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Profiler::Profiler(std::vector<std::string> const& v_Phase) : v_Name(v_Phase),
+                                                              v_Histogram(v_Phase.size())
+{}
+
+Profiler::~Profiler() noexcept
+{}
+
+//*************************************************************************************
+// Record
+//*************************************************************************************
+
+void Profiler::Record(size_t us_Phase, uint64_t u64_Start) noexcept
+{
+    if (us_Phase < v_Histogram.size())
+    {
+        v_Histogram[us_Phase].Add(GetTime() - u64_Start);
+    }
+}
+
+//*************************************************************************************
+// Summary
+//*************************************************************************************
+
+void Profiler::LogSummary() noexcept
+{
+    Logger& c_Logger = Logger::Singleton();
+    
+    // The summary is requested explicitly, keep it in builds without 
+    // compiled info messages and never rate limit it
+    for (size_t i = 0; i < v_Histogram.size(); ++i)
+    {
+        Histogram& c_Histogram = v_Histogram[i];
+        
+        // Times are logged in microseconds
+        c_Logger.LogFormatUnlimited(Logger::INFO, "Profiler.cpp", __LINE__,
+                                    "{}: n={}, p50={}us, p99={}us, max={}us",
+                                    v_Name[i],
+                                    c_Histogram.GetCount(),
+                                    c_Histogram.GetPercentile(50.0) / 1000,
+                                    c_Histogram.GetPercentile(99.0) / 1000,
+                                    c_Histogram.GetMax() / 1000);
+        
+        c_Histogram.Reset();
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+uint64_t Profiler::GetTime() noexcept
+{
+    struct timespec c_Time;
+    clock_gettime(CLOCK_MONOTONIC, &c_Time);
+    
+    return ((uint64_t)c_Time.tv_sec * 1000000000ULL) + (uint64_t)c_Time.tv_nsec;
+}
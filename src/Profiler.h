@@ -0,0 +1,109 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Profiler_h
+#define Profiler_h
+
+// C / C++
+#include <vector>
+#include <string>
+
+// External
+
+// Project
+#include "./Histogram.h"
+
+
+class Profiler
+{
+public:
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     *
+     *  \param v_Phase The names of the phases to measure.
+     */
+    
+    Profiler(std::vector<std::string> const& v_Phase);
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_Profiler Profiler class source.
+     */
+    
+    Profiler(Profiler const& c_Profiler) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Profiler() noexcept;
+    
+    //*************************************************************************************
+    // Record
+    //*************************************************************************************
+    
+    /**
+     *  Record the time spent in a phase.
+     *
+     *  \param us_Phase The phase to record.
+     *  \param u64_Start The phase start time from GetTime().
+     */
+    
+    void Record(size_t us_Phase, uint64_t u64_Start) noexcept;
+    
+    //*************************************************************************************
+    // Summary
+    //*************************************************************************************
+    
+    /**
+     *  Log the p50, p99 and max time of all phases and reset the recorded
+     *  times.
+     */
+    
+    void LogSummary() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the current monotonic time.
+     *
+     *  \return The monotonic time in nanoseconds.
+     */
+    
+    static uint64_t GetTime() noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    std::vector<std::string> v_Name;
+    std::vector<Histogram> v_Histogram;
+    
+protected:
+    
+};
+
+#endif /* Profiler_h */
@@ -0,0 +1,386 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <sys/epoll.h>
+#include <sys/signalfd.h>
+#include <sys/timerfd.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#include <csignal>
+#include <cerrno>
+#include <cstring>
+#include <ctime>
+
+// External
+
+// Project
+#include "./Reactor.h"
+#include "./Logger.h"
+
+// Pre-defined
+namespace
+{
+    // Signals handled by the reactor
+    const int p_Signal[] =
+    {
+        SIGTERM,
+        SIGHUP,
+        SIGUSR2
+    };
+    
+    constexpr size_t us_SignalCount = sizeof(p_Signal) / sizeof(int);
+    
+    // Time zone file, replaced instead of written so watch the directory
+    const char* p_TimeZoneDirectory = "/etc";
+    const char* p_TimeZoneFile = "localtime";
+    
+    // Epoll
+    constexpr int i_MaxEpollEvents = 4;
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Reactor::Reactor(TimeSource const& c_TimeSource) : c_TimeSource(c_TimeSource),
+                                                   i_EpollFD(-1),
+                                                   i_SignalFD(-1),
+                                                   i_TimerFD(-1),
+                                                   i_StopFD(-1),
+                                                   i_TimeZoneFD(-1)
+{
+    // Register our SDL event first, the main loop waits on SDL
+    if (GetEventType() == (Uint32)-1)
+    {
+        throw Exception("Failed to register reactor event!");
+    }
+    
+    // Create all descriptors to wait on
+    sigset_t c_Set;
+    sigemptyset(&c_Set);
+    
+    for (size_t i = 0; i < us_SignalCount; ++i)
+    {
+        sigaddset(&c_Set, p_Signal[i]);
+    }
+    
+    i_SignalFD = signalfd(-1, &c_Set, SFD_NONBLOCK | SFD_CLOEXEC);
+    i_TimerFD = timerfd_create(CLOCK_REALTIME, TFD_NONBLOCK | TFD_CLOEXEC);
+    i_StopFD = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    i_EpollFD = epoll_create1(EPOLL_CLOEXEC);
+    
+    if (i_SignalFD < 0 || i_TimerFD < 0 || i_StopFD < 0 || i_EpollFD < 0)
+    {
+        Close();
+        throw Exception("Failed to create reactor descriptors!");
+    }
+    
+    // Add descriptors to epoll
+    for (int i_FD : { i_SignalFD, i_TimerFD, i_StopFD })
+    {
+        struct epoll_event c_Event;
+        c_Event.events = EPOLLIN;
+        c_Event.data.fd = i_FD;
+        
+        if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_FD, &c_Event) < 0)
+        {
+            Close();
+            throw Exception("Failed to add reactor descriptor!");
+        }
+    }
+    
+    if (ArmTimer() == false)
+    {
+        Close();
+        throw Exception("Failed to arm reactor timer!");
+    }
+    
+    // Time zone changes are optional, the clock keeps the old zone
+    i_TimeZoneFD = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    
+    if (i_TimeZoneFD >= 0 && inotify_add_watch(i_TimeZoneFD,
+                                               p_TimeZoneDirectory,
+                                               IN_CREATE | IN_MOVED_TO | IN_CLOSE_WRITE | IN_ATTRIB | IN_DELETE) >= 0)
+    {
+        struct epoll_event c_Event;
+        c_Event.events = EPOLLIN;
+        c_Event.data.fd = i_TimeZoneFD;
+        
+        if (epoll_ctl(i_EpollFD, EPOLL_CTL_ADD, i_TimeZoneFD, &c_Event) < 0)
+        {
+            close(i_TimeZoneFD);
+            i_TimeZoneFD = -1;
+        }
+    }
+    else if (i_TimeZoneFD >= 0)
+    {
+        close(i_TimeZoneFD);
+        i_TimeZoneFD = -1;
+    }
+    
+    if (i_TimeZoneFD < 0)
+    {
+        MRANGEUI_LOG_WARNING("Failed to watch time zone changes!");
+    }
+    
+    // Descriptors are ready, now wait for events
+    try
+    {
+        c_Thread = std::thread(&Reactor::Run, this);
+    }
+    catch (std::exception& e)
+    {
+        Close();
+        throw Exception("Failed to start reactor thread: " + std::string(e.what()));
+    }
+}
+
+Reactor::~Reactor() noexcept
+{
+    Close();
+}
+
+void Reactor::Close() noexcept
+{
+    if (c_Thread.joinable() == true)
+    {
+        uint64_t u64_Stop = 1;
+        
+        if (write(i_StopFD, &u64_Stop, sizeof(u64_Stop)) == sizeof(u64_Stop))
+        {
+            c_Thread.join();
+        }
+        else
+        {
+            c_Thread.detach();
+        }
+    }
+    
+    for (int* p_FD : { &i_EpollFD, &i_SignalFD, &i_TimerFD, &i_StopFD, &i_TimeZoneFD })
+    {
+        if (*p_FD >= 0)
+        {
+            close(*p_FD);
+            *p_FD = -1;
+        }
+    }
+}
+
+//*************************************************************************************
+// Signals
+//*************************************************************************************
+
+bool Reactor::BlockSignals() noexcept
+{
+    sigset_t c_Set;
+    sigemptyset(&c_Set);
+    
+    for (size_t i = 0; i < us_SignalCount; ++i)
+    {
+        sigaddset(&c_Set, p_Signal[i]);
+    }
+    
+    return pthread_sigmask(SIG_BLOCK, &c_Set, NULL) == 0;
+}
+
+//*************************************************************************************
+// Run
+//*************************************************************************************
+
+void Reactor::Run() noexcept
+{
+    struct epoll_event p_Event[i_MaxEpollEvents];
+    
+    while (true)
+    {
+        int i_Count = epoll_wait(i_EpollFD, p_Event, i_MaxEpollEvents, -1);
+        
+        if (i_Count < 0)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            
+            MRANGEUI_LOG_ERROR("Reactor wait failed!");
+            return;
+        }
+        
+        for (int i = 0; i < i_Count; ++i)
+        {
+            int i_FD = p_Event[i].data.fd;
+            
+            if (i_FD == i_StopFD)
+            {
+                return;
+            }
+            else if (i_FD == i_TimerFD)
+            {
+                uint64_t u64_Expired;
+                
+                // ECANCELED means the wall clock was set, rearm for the
+                // new minute boundary and update right away
+                if (read(i_TimerFD, &u64_Expired, sizeof(u64_Expired)) < 0)
+                {
+                    if (errno != ECANCELED)
+                    {
+                        continue;
+                    }
+                    else if (ArmTimer() == false)
+                    {
+                        MRANGEUI_LOG_ERROR("Failed to rearm reactor timer!");
+                    }
+                }
+                
+                Wake(TIMER, 0);
+            }
+            else if (i_FD == i_SignalFD)
+            {
+                struct signalfd_siginfo c_Info;
+                
+                while (read(i_SignalFD, &c_Info, sizeof(c_Info)) == sizeof(c_Info))
+                {
+                    Wake(SIGNAL, (int)(c_Info.ssi_signo));
+                }
+            }
+            else if (i_FD == i_TimeZoneFD)
+            {
+                if (ReadTimeZone() == true)
+                {
+                    Wake(TIME_ZONE, 0);
+                }
+            }
+        }
+    }
+}
+
+//*************************************************************************************
+// Timer
+//*************************************************************************************
+
+bool Reactor::ArmTimer() noexcept
+{
+    struct itimerspec c_Timer;
+    memset(&c_Timer, 0, sizeof(c_Timer));
+    
+    switch (c_TimeSource.GetMode())
+    {
+        case TimeSource::FIXED:
+        {
+            // Time never changes, keep the timer disarmed
+            return timerfd_settime(i_TimerFD, 0, &c_Timer, NULL) == 0;
+        }
+        
+        case TimeSource::TIME_LAPSE:
+        {
+            // Expire once per simulated minute, a zero interval would 
+            // disarm the timer
+            long l_Interval = 1000000000L / c_TimeSource.GetMinutesPerSecond();
+            
+            if (l_Interval < 1)
+            {
+                l_Interval = 1;
+            }
+            
+            c_Timer.it_value.tv_sec = l_Interval / 1000000000L;
+            c_Timer.it_value.tv_nsec = l_Interval % 1000000000L;
+            c_Timer.it_interval = c_Timer.it_value;
+            
+            return timerfd_settime(i_TimerFD, 0, &c_Timer, NULL) == 0;
+        }
+        
+        default:
+        {
+            struct timespec c_Now;
+            
+            if (clock_gettime(CLOCK_REALTIME, &c_Now) < 0)
+            {
+                return false;
+            }
+            
+            // Expire on every full minute, cancel if the clock is set
+            c_Timer.it_value.tv_sec = (c_Now.tv_sec - (c_Now.tv_sec % 60)) + 60;
+            c_Timer.it_value.tv_nsec = 0;
+            c_Timer.it_interval.tv_sec = 60;
+            c_Timer.it_interval.tv_nsec = 0;
+            
+            return timerfd_settime(i_TimerFD,
+                                   TFD_TIMER_ABSTIME | TFD_TIMER_CANCEL_ON_SET,
+                                   &c_Timer,
+                                   NULL) == 0;
+        }
+    }
+}
+
+//*************************************************************************************
+// Time Zone
+//*************************************************************************************
+
+bool Reactor::ReadTimeZone() noexcept
+{
+    alignas(struct inotify_event) char p_Buffer[4096];
+    bool b_Changed = false;
+    ssize_t ss_Size;
+    
+    while ((ss_Size = read(i_TimeZoneFD, p_Buffer, sizeof(p_Buffer))) > 0)
+    {
+        for (ssize_t i = 0; i < ss_Size;)
+        {
+            struct inotify_event* p_Event = (struct inotify_event*)&(p_Buffer[i]);
+            
+            if (p_Event->len > 0 && strcmp(p_Event->name, p_TimeZoneFile) == 0)
+            {
+                b_Changed = true;
+            }
+            
+            i += sizeof(struct inotify_event) + p_Event->len;
+        }
+    }
+    
+    return b_Changed;
+}
+
+//*************************************************************************************
+// Wake
+//*************************************************************************************
+
+void Reactor::Wake(WakeCode e_Code, int i_Data) noexcept
+{
+    SDL_Event c_Event;
+    SDL_zero(c_Event);
+    
+    c_Event.type = GetEventType();
+    c_Event.user.code = e_Code;
+    c_Event.user.data1 = (void*)((intptr_t)i_Data);
+    
+    if (SDL_PushEvent(&c_Event) < 0)
+    {
+        MRANGEUI_LOG_ERROR("Failed to push reactor event!");
+    }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+Uint32 Reactor::GetEventType() noexcept
+{
+    static Uint32 u32_EventType = SDL_RegisterEvents(1);
+    return u32_EventType;
+}
@@ -0,0 +1,186 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef Reactor_h
+#define Reactor_h
+
+// C / C++
+#include <thread>
+
+// External
+#include <SDL2/SDL.h>
+
+// Project
+#include "./TimeSource.h"
+#include "./Exception.h"
+
+
+class Reactor
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    typedef enum
+    {
+        TIMER = 0, // The next minute of the time source was reached
+        SIGNAL = 1, // A signal was recieved, data1 holds the signal number
+        REDRAW = 2, // Something outside the main loop requested a redraw
+        TIME_ZONE = 3, // The system time zone file changed
+        
+        WAKE_CODE_MAX = TIME_ZONE,
+        
+        WAKE_CODE_COUNT = WAKE_CODE_MAX + 1
+        
+    }WakeCode;
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor. SDL has to be initialized and BlockSignals() called
+     *  before the reactor is created.
+     *  
+     *  \param c_TimeSource The time source to send minute updates for. The 
+     *                      time source has to outlive the reactor.
+     */
+    
+    Reactor(TimeSource const& c_TimeSource);
+    
+    /**
+     *  Copy constructor. Disabled for this class.
+     *
+     *  \param c_Reactor Reactor class source.
+     */
+    
+    Reactor(Reactor const& c_Reactor) = delete;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~Reactor() noexcept;
+    
+    //*************************************************************************************
+    // Signals
+    //*************************************************************************************
+    
+    /**
+     *  Block the signals handled by the reactor for the calling thread. This
+     *  has to be called before any other thread is created so that all threads
+     *  inherit the signal mask.
+     *
+     *  \return true if the signals were blocked, false if not.
+     */
+    
+    static bool BlockSignals() noexcept;
+    
+    //*************************************************************************************
+    // Wake
+    //*************************************************************************************
+    
+    /**
+     *  Push a reactor event to the SDL event queue. This function is thread 
+     *  safe.
+     *  
+     *  \param e_Code The wake code for the event.
+     *  \param i_Data The event data.
+     */
+    
+    static void Wake(WakeCode e_Code, int i_Data) noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the SDL event type used for reactor events. The event type is 
+     *  registered on first use.
+     *  
+     *  \return The SDL event type, (Uint32)-1 if none could be registered.
+     */
+    
+    static Uint32 GetEventType() noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Close
+    //*************************************************************************************
+    
+    /**
+     *  Stop the reactor thread and close all descriptors.
+     */
+    
+    void Close() noexcept;
+    
+    //*************************************************************************************
+    // Run
+    //*************************************************************************************
+    
+    /**
+     *  Wait for timer and signal events and forward them as SDL events.
+     */
+    
+    void Run() noexcept;
+    
+    //*************************************************************************************
+    // Timer
+    //*************************************************************************************
+    
+    /**
+     *  Arm the timer for the next minute of the time source. Fixed time 
+     *  sources leave the timer disarmed.
+     *
+     *  \return true if the timer was armed, false if not.
+     */
+    
+    bool ArmTimer() noexcept;
+    
+    //*************************************************************************************
+    // Time Zone
+    //*************************************************************************************
+    
+    /**
+     *  Read all pending time zone watch events.
+     *
+     *  \return true if the time zone file changed, false if not.
+     */
+    
+    bool ReadTimeZone() noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    TimeSource const& c_TimeSource;
+    
+    int i_EpollFD;
+    int i_SignalFD;
+    int i_TimerFD;
+    int i_StopFD;
+    int i_TimeZoneFD;
+    
+    std::thread c_Thread;
+    
+protected:
+    
+};
+
+#endif /* Reactor_h */
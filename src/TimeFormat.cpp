@@ -0,0 +1,356 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <langinfo.h>
+#include <clocale>
+#include <cstring>
+
+// External
+
+// Project
+#include "./TimeFormat.h"
+
+// Pre-defined
+namespace
+{
+    // Used if the locale has no pattern
+    const char* p_DefaultPattern[TimeFormat::PATTERN_COUNT] =
+    {
+        "%H:%M",
+        "%d.%m.%Y"
+    };
+    
+    // Produced by every numeric conversion
+    const char* p_Digits = "0123456789";
+    
+    void AddCharacters(bool* p_Used, size_t us_Count, const char* p_Source) noexcept
+    {
+        if (p_Source == NULL)
+        {
+            return;
+        }
+        
+        for (; *p_Source != '\0'; ++p_Source)
+        {
+            size_t us_Character = (unsigned char)*p_Source;
+            
+            if (us_Character < us_Count)
+            {
+                p_Used[us_Character] = true;
+            }
+        }
+    }
+    
+    void AddNames(bool* p_Used, size_t us_Count, nl_item i_First, int i_Names) noexcept
+    {
+        for (int i = 0; i < i_Names; ++i)
+        {
+            AddCharacters(p_Used, us_Count, nl_langinfo((nl_item)(i_First + i)));
+        }
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+TimeFormat::TimeFormat() noexcept : u32_Generation(1),
+                                     c_Locale((locale_t)0)
+{
+    for (size_t i = 0; i < PATTERN_COUNT; ++i)
+    {
+        strcpy(p_Pattern[i], p_DefaultPattern[i]);
+        UpdateCharacters((Pattern)i);
+    }
+    
+    p_Locale[0] = '\0';
+    
+    Update();
+}
+
+TimeFormat::~TimeFormat() noexcept
+{}
+
+//*************************************************************************************
+// Update
+//*************************************************************************************
+
+void TimeFormat::Update() noexcept
+{
+    // Thread locales are replaced instead of changed, the global locale 
+    // is compared by name
+    locale_t c_Current = uselocale((locale_t)0);
+    const char* p_Current = (c_Current == LC_GLOBAL_LOCALE ? setlocale(LC_TIME, NULL) : "");
+    
+    if (p_Current == NULL || 
+        (c_Current == c_Locale && strncmp(p_Current, p_Locale, us_LocaleSize) == 0))
+    {
+        return;
+    }
+    
+    c_Locale = c_Current;
+    strncpy(p_Locale, p_Current, us_LocaleSize - 1);
+    p_Locale[us_LocaleSize - 1] = '\0';
+    
+    // Time without seconds, the clock only shows minutes
+    size_t us_Time = AppendPattern(p_Pattern[TIME], 0, nl_langinfo(T_FMT), false);
+    size_t us_Date = AppendPattern(p_Pattern[DATE], 0, nl_langinfo(D_FMT), true);
+    
+    if (us_Time == 0)
+    {
+        strcpy(p_Pattern[TIME], p_DefaultPattern[TIME]);
+    }
+    
+    if (us_Date == 0)
+    {
+        strcpy(p_Pattern[DATE], p_DefaultPattern[DATE]);
+    }
+    
+    for (size_t i = 0; i < PATTERN_COUNT; ++i)
+    {
+        UpdateCharacters((Pattern)i);
+    }
+    
+    ++u32_Generation;
+}
+
+//*************************************************************************************
+// Format
+//*************************************************************************************
+
+size_t TimeFormat::Format(char* p_Buffer, size_t us_Size, Pattern e_Pattern, struct tm const& c_Time) const noexcept
+{
+    if (us_Size == 0 || e_Pattern > PATTERN_MAX)
+    {
+        return 0;
+    }
+    
+    size_t us_Length = strftime(p_Buffer, us_Size, p_Pattern[e_Pattern], &c_Time);
+    
+    if (us_Length == 0)
+    {
+        p_Buffer[0] = '\0';
+    }
+    
+    return us_Length;
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+const char* TimeFormat::GetCharacters(Pattern e_Pattern) const noexcept
+{
+    return e_Pattern > PATTERN_MAX ? "" : p_Characters[e_Pattern];
+}
+
+uint32_t TimeFormat::GetGeneration() const noexcept
+{
+    return u32_Generation;
+}
+
+//*************************************************************************************
+// Patterns
+//*************************************************************************************
+
+size_t TimeFormat::AppendPattern(char* p_Pattern, size_t us_Pos, const char* p_Source, bool b_Seconds) noexcept
+{
+    if (p_Source == NULL)
+    {
+        return 0;
+    }
+    
+    for (; *p_Source != '\0'; ++p_Source)
+    {
+        const char* p_Expand = NULL;
+        char p_Conversion[4] = { *p_Source, '\0', '\0', '\0' };
+        
+        if (*p_Source == '%' && p_Source[1] != '\0')
+        {
+            // Keep E and O modifiers with their conversion
+            size_t us_Length = ((p_Source[1] == 'E' || p_Source[1] == 'O') && p_Source[2] != '\0' ? 2 : 1);
+            
+            memcpy(&(p_Conversion[1]), &(p_Source[1]), us_Length);
+            p_Source += us_Length;
+            
+            switch (*p_Source)
+            {
+                case 'r':
+                    p_Expand = nl_langinfo(T_FMT_AMPM);
+                    
+                    if (p_Expand == NULL || *p_Expand == '\0')
+                    {
+                        p_Expand = "%I:%M:%S %p";
+                    }
+                    break;
+                case 'T':
+                    p_Expand = "%H:%M:%S";
+                    break;
+                case 'R':
+                    p_Expand = "%H:%M";
+                    break;
+                case 'D':
+                    p_Expand = "%m/%d/%y";
+                    break;
+                case 'S':
+                    // Drop seconds together with their separator and unit
+                    if (b_Seconds == false)
+                    {
+                        while (us_Pos > 0 && (p_Pattern[us_Pos - 1] == ':' || p_Pattern[us_Pos - 1] == '.'))
+                        {
+                            --us_Pos;
+                        }
+                        
+                        while (p_Source[1] != '\0' && p_Source[1] != '%' && p_Source[1] != ' ')
+                        {
+                            ++p_Source;
+                        }
+                        
+                        continue;
+                    }
+                    break;
+                
+                default:
+                    break;
+            }
+        }
+        
+        if (p_Expand != NULL)
+        {
+            // Combined conversions contain no further combined conversions
+            if ((us_Pos = AppendPattern(p_Pattern, us_Pos, p_Expand, b_Seconds)) == 0)
+            {
+                return 0;
+            }
+            
+            continue;
+        }
+        
+        size_t us_Length = strlen(p_Conversion);
+        
+        if (us_Pos + us_Length >= us_PatternSize)
+        {
+            return 0;
+        }
+        
+        memcpy(&(p_Pattern[us_Pos]), p_Conversion, us_Length);
+        us_Pos += us_Length;
+    }
+    
+    p_Pattern[us_Pos] = '\0';
+    
+    return us_Pos;
+}
+
+void TimeFormat::UpdateCharacters(Pattern e_Pattern) noexcept
+{
+    bool p_Used[us_CharacterCount] = { false };
+    
+    // Literal characters and the output of each conversion
+    AddCharacters(p_Used, us_CharacterCount, p_Digits);
+    
+    for (const char* p_Source = p_Pattern[e_Pattern]; *p_Source != '\0'; ++p_Source)
+    {
+        if (*p_Source != '%' || p_Source[1] == '\0')
+        {
+            char p_Literal[2] = { *p_Source, '\0' };
+            AddCharacters(p_Used, us_CharacterCount, p_Literal);
+            continue;
+        }
+        
+        // Skip flags, widths and E and O modifiers, names can change case
+        bool p_Conversion[us_CharacterCount] = { false };
+        bool b_Upper = false;
+        
+        do
+        {
+            b_Upper |= (*(++p_Source) == '^');
+        }
+        while (p_Source[1] != '\0' && strchr("_-0^#EO123456789", *p_Source) != NULL);
+        
+        switch (*p_Source)
+        {
+            case 'p':
+            case 'P':
+                AddCharacters(p_Conversion, us_CharacterCount, nl_langinfo(AM_STR));
+                AddCharacters(p_Conversion, us_CharacterCount, nl_langinfo(PM_STR));
+                break;
+            case 'a':
+                AddNames(p_Conversion, us_CharacterCount, ABDAY_1, 7);
+                break;
+            case 'A':
+                AddNames(p_Conversion, us_CharacterCount, DAY_1, 7);
+                break;
+            case 'b':
+            case 'h':
+                AddNames(p_Conversion, us_CharacterCount, ABMON_1, 12);
+                break;
+            case 'B':
+                AddNames(p_Conversion, us_CharacterCount, MON_1, 12);
+                break;
+            case 'z':
+                AddCharacters(p_Conversion, us_CharacterCount, "+-");
+                break;
+            case 'n':
+                AddCharacters(p_Conversion, us_CharacterCount, "\n");
+                break;
+            case 't':
+                AddCharacters(p_Conversion, us_CharacterCount, "\t");
+                break;
+            case '%':
+                AddCharacters(p_Conversion, us_CharacterCount, "%");
+                break;
+            
+            default:
+                // Numeric, digits are always included
+                break;
+        }
+        
+        for (size_t i = 0; i < us_CharacterCount; ++i)
+        {
+            if (p_Conversion[i] == false)
+            {
+                continue;
+            }
+            else if (i >= 'a' && i <= 'z' && b_Upper == true)
+            {
+                p_Used[i - ('a' - 'A')] = true;
+            }
+            else if (i >= 'A' && i <= 'Z' && *p_Source == 'P')
+            {
+                p_Used[i + ('a' - 'A')] = true;
+            }
+            else
+            {
+                p_Used[i] = true;
+            }
+        }
+    }
+    
+    size_t us_Pos = 0;
+    
+    for (size_t i = 1; i < us_CharacterCount; ++i)
+    {
+        if (p_Used[i] == true)
+        {
+            p_Characters[e_Pattern][us_Pos++] = (char)i;
+        }
+    }
+    
+    p_Characters[e_Pattern][us_Pos] = '\0';
+}
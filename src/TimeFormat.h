@@ -0,0 +1,164 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef TimeFormat_h
+#define TimeFormat_h
+
+// C / C++
+#include <ctime>
+#include <clocale>
+#include <cstdint>
+
+// External
+
+// Project
+
+
+class TimeFormat
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    typedef enum
+    {
+        TIME = 0, // Hours and minutes, 12h or 24h by locale
+        DATE = 1, // The locale date representation
+        
+        PATTERN_MAX = DATE,
+        
+        PATTERN_COUNT = PATTERN_MAX + 1
+        
+    }Pattern;
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor.
+     */
+    
+    TimeFormat() noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~TimeFormat() noexcept;
+    
+    //*************************************************************************************
+    // Update
+    //*************************************************************************************
+    
+    /**
+     *  Resolve the patterns again if the time locale of the calling thread 
+     *  changed.
+     */
+    
+    void Update() noexcept;
+    
+    //*************************************************************************************
+    // Format
+    //*************************************************************************************
+    
+    /**
+     *  Format a time with a pattern. No memory is allocated.
+     *
+     *  \param p_Buffer The buffer to write the terminated string to.
+     *  \param us_Size The buffer size.
+     *  \param e_Pattern The pattern to use.
+     *  \param c_Time The time to format.
+     *
+     *  \return The string length, 0 if the buffer was too small.
+     */
+    
+    size_t Format(char* p_Buffer, size_t us_Size, Pattern e_Pattern, struct tm const& c_Time) const noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the ASCII characters a pattern can produce. Characters of time 
+     *  zone names are not included.
+     *
+     *  \param e_Pattern The pattern to get the characters for.
+     *
+     *  
+eturn The terminated characters, each included once.
+     */
+    
+    const char* GetCharacters(Pattern e_Pattern) const noexcept;
+    
+    /**
+     *  Get the pattern generation. The generation changes whenever the 
+     *  patterns are resolved again for a new locale, 0 is never used.
+     *
+     *  \return The pattern generation.
+     */
+    
+    uint32_t GetGeneration() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Patterns
+    //*************************************************************************************
+    
+    static constexpr size_t us_PatternSize = 64;
+    static constexpr size_t us_LocaleSize = 64;
+    static constexpr size_t us_CharacterCount = 128; // ASCII
+    
+    /**
+     *  Append a locale pattern, expanding combined conversions.
+     *
+     *  \param p_Pattern The pattern to append to.
+     *  \param us_Pos The current pattern length.
+     *  \param p_Source The locale pattern to append.
+     *  \param b_Seconds Keep seconds conversions.
+     *
+     *  \return The new pattern length.
+     */
+    
+    static size_t AppendPattern(char* p_Pattern, size_t us_Pos, const char* p_Source, bool b_Seconds) noexcept;
+    
+    /**
+     *  Collect the characters a resolved pattern can produce with the 
+     *  current locale.
+     *
+     *  \param e_Pattern The pattern to collect the characters for.
+     */
+    
+    void UpdateCharacters(Pattern e_Pattern) noexcept;
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    char p_Pattern[PATTERN_COUNT][us_PatternSize];
+    char p_Characters[PATTERN_COUNT][us_CharacterCount + 1];
+    uint32_t u32_Generation;
+    locale_t c_Locale; // Thread locale the patterns were resolved for
+    char p_Locale[us_LocaleSize]; // LC_TIME the patterns were resolved for
+    
+protected:
+    
+};
+
+#endif /* TimeFormat_h */
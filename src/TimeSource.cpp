@@ -0,0 +1,151 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+// C / C++
+#include <cmath>
+#include <ctime>
+
+// External
+
+// Project
+#include "./TimeSource.h"
+
+// Pre-defined
+namespace
+{
+    long GetCoarseResolution() noexcept
+    {
+        struct timespec c_Resolution;
+        
+        if (clock_getres(CLOCK_REALTIME_COARSE, &c_Resolution) < 0 || c_Resolution.tv_sec > 0)
+        {
+            return -1;
+        }
+        
+        return c_Resolution.tv_nsec;
+    }
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+TimeSource::TimeSource() noexcept : e_Mode(WALL),
+                                    us_Start(0),
+                                    c_Start(std::chrono::steady_clock::now()),
+                                    i_MinutesPerSecond(1)
+{}
+
+TimeSource::TimeSource(Mode e_Mode, int i_StartMinute, int i_MinutesPerSecond) noexcept : e_Mode(e_Mode),
+                                                                                         us_Start(time(NULL)),
+                                                                                         c_Start(std::chrono::steady_clock::now()),
+                                                                                         i_MinutesPerSecond(i_MinutesPerSecond > 0 ? i_MinutesPerSecond : 1)
+{
+    // Start at the given minute of today, on a full minute
+    struct tm c_LocalTime;
+    localtime_r(&us_Start, &c_LocalTime);
+    
+    if (i_StartMinute >= 0)
+    {
+        c_LocalTime.tm_hour = (i_StartMinute / 60) % 24;
+        c_LocalTime.tm_min = i_StartMinute % 60;
+    }
+    
+    c_LocalTime.tm_sec = 0;
+    c_LocalTime.tm_isdst = -1;
+    
+    us_Start = mktime(&c_LocalTime);
+}
+
+TimeSource::~TimeSource() noexcept
+{}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+time_t TimeSource::GetTime() const noexcept
+{
+    switch (e_Mode)
+    {
+        case FIXED:
+            return us_Start;
+        
+        case TIME_LAPSE:
+        {
+            // Round to the nearest simulated minute, the reactor tick
+            // might arrive slightly before the minute boundary
+            double f64_Elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - c_Start).count();
+            return us_Start + (time_t)(std::llround(f64_Elapsed * i_MinutesPerSecond) * 60);
+        }
+        
+        default:
+            return GetWallTime();
+    }
+}
+
+time_t TimeSource::GetWallTime() noexcept
+{
+    static const long l_Resolution = GetCoarseResolution();
+    struct timespec c_Time;
+    
+    if (l_Resolution < 0 || clock_gettime(CLOCK_REALTIME_COARSE, &c_Time) < 0)
+    {
+        return time(NULL);
+    }
+    
+    // The coarse clock trails the real clock by up to one tick, add it
+    // so that a minute timer never reads the previous minute
+    return c_Time.tv_sec + ((c_Time.tv_nsec + l_Resolution) >= 1000000000L ? 1 : 0);
+}
+
+double TimeSource::GetPreciseTime() const noexcept
+{
+    switch (e_Mode)
+    {
+        case FIXED:
+            return (double)us_Start;
+        
+        case TIME_LAPSE:
+        {
+            double f64_Elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - c_Start).count();
+            return (double)us_Start + (f64_Elapsed * i_MinutesPerSecond * 60.0);
+        }
+        
+        default:
+        {
+            struct timespec c_Time;
+            
+            if (clock_gettime(CLOCK_REALTIME_COARSE, &c_Time) < 0)
+            {
+                return (double)time(NULL);
+            }
+            
+            return (double)c_Time.tv_sec + ((double)c_Time.tv_nsec / 1000000000.0);
+        }
+    }
+}
+
+TimeSource::Mode TimeSource::GetMode() const noexcept
+{
+    return e_Mode;
+}
+
+int TimeSource::GetMinutesPerSecond() const noexcept
+{
+    return i_MinutesPerSecond;
+}
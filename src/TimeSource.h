@@ -0,0 +1,139 @@
+/**
+ *  Copyright (C) 2021 - 2022 The MRH Project Authors.
+ * 
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *  http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ */
+
+#ifndef TimeSource_h
+#define TimeSource_h
+
+// C / C++
+#include <ctime>
+#include <chrono>
+
+// External
+
+// Project
+
+
+class TimeSource
+{
+public:
+    
+    //*************************************************************************************
+    // Types
+    //*************************************************************************************
+    
+    typedef enum
+    {
+        WALL = 0, // The system wall clock
+        FIXED = 1, // A fixed instant which never changes
+        TIME_LAPSE = 2, // Accelerated time from a start instant
+        
+        MODE_MAX = TIME_LAPSE,
+        
+        MODE_COUNT = MODE_MAX + 1
+        
+    }Mode;
+    
+    //*************************************************************************************
+    // Constructor / Destructor
+    //*************************************************************************************
+    
+    /**
+     *  Default constructor. The time source uses the wall clock.
+     */
+    
+    TimeSource() noexcept;
+    
+    /**
+     *  Mode constructor.
+     *
+     *  \param e_Mode The time source mode.
+     *  \param i_StartMinute The minute of the current day to start at, -1 to
+     *                       start at the current time. Unused for WALL.
+     *  \param i_MinutesPerSecond The simulated minutes per real second for
+     *                            TIME_LAPSE.
+     */
+    
+    TimeSource(Mode e_Mode, int i_StartMinute, int i_MinutesPerSecond) noexcept;
+    
+    /**
+     *  Default destructor.
+     */
+    
+    ~TimeSource() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the current time of the time source. This function is thread safe.
+     *
+     *  \return The current time.
+     */
+    
+    time_t GetTime() const noexcept;
+    
+    /**
+     *  Get the current wall clock time from the coarse system clock. This 
+     *  function is thread safe.
+     *
+     *  \return The current wall clock time.
+     */
+    
+    static time_t GetWallTime() noexcept;
+    
+    /**
+     *  Get the current time of the time source with sub-second precision. 
+     *  This function is thread safe.
+     *
+     *  \return The current time in seconds.
+     */
+    
+    double GetPreciseTime() const noexcept;
+    
+    /**
+     *  Get the time source mode.
+     *
+     *  \return The time source mode.
+     */
+    
+    Mode GetMode() const noexcept;
+    
+    /**
+     *  Get the simulated minutes per real second.
+     *
+     *  \return The simulated minutes per real second.
+     */
+    
+    int GetMinutesPerSecond() const noexcept;
+    
+private:
+    
+    //*************************************************************************************
+    // Data
+    //*************************************************************************************
+    
+    Mode e_Mode;
+    
+    time_t us_Start;
+    std::chrono::steady_clock::time_point c_Start;
+    int i_MinutesPerSecond;
+    
+protected:
+    
+};
+
+#endif /* TimeSource_h */
@@ -15,6 +15,14 @@
  */
 
 // C / C++
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cstdio>
+#include <ctime>
+#include <cstring>
+#include <cerrno>
+#include <algorithm>
 
 // External
 
@@ -32,44 +40,159 @@
     #define UI_FONT_PATH "/var/mrh/mrangeui/Font.ttf"
 #endif
 
+namespace
+{
+    enum Component
+    {
+        BACKGROUND = 0,
+        TODAY_INFO = 1,
+        
+        COMPONENT_MAX = TODAY_INFO,
+        
+        COMPONENT_COUNT = COMPONENT_MAX + 1
+    };
+    
+    // Component updates use the component index as phase
+    enum Phase
+    {
+        PHASE_UPDATE_BACKGROUND = BACKGROUND,
+        PHASE_UPDATE_TODAY_INFO = TODAY_INFO,
+        PHASE_COMPOSE = 2,
+        PHASE_PRESENT = 3,
+        PHASE_FRAME = 4,
+        
+        PHASE_MAX = PHASE_FRAME,
+        
+        PHASE_COUNT = PHASE_MAX + 1
+    };
+    
+    const std::vector<std::string> v_PhaseName =
+    {
+        "Update Background",
+        "Update TodayInfo",
+        "Compose",
+        "Present",
+        "Frame"
+    };
+    
+    // Snapshots within the same part of the day look alike
+    constexpr int i_SnapshotBucketMinutes = 30;
+    
+    int GetSnapshotBucket(time_t us_Time) noexcept
+    {
+        struct tm c_Time;
+        
+        if (localtime_r(&us_Time, &c_Time) == NULL)
+        {
+            return -1;
+        }
+        
+        return ((c_Time.tm_hour * 60) + c_Time.tm_min) / i_SnapshotBucketMinutes;
+    }
+    
+    bool SyncPath(const char* p_Path, int i_Flags) noexcept
+    {
+        int i_FD = open(p_Path, i_Flags | O_CLOEXEC);
+        
+        if (i_FD < 0)
+        {
+            return false;
+        }
+        
+        bool b_Result = (fsync(i_FD) == 0);
+        close(i_FD);
+        
+        return b_Result;
+    }
+}
+
 
 //*************************************************************************************
 // Constructor / Destructor
 //*************************************************************************************
 
 UI::UI(int i_W,
-       int i_H) : p_Window(NULL),
-                  p_Renderer(NULL),
-                  i_W(-1), // Keep -1 for UpdateSize()
-                  i_H(-1)
+       int i_H,
+       bool b_Headless,
+       bool b_VSync,
+       int i_SolarRate,
+       std::string const& s_FrameDirectory,
+       std::string const& s_SnapshotDirectory) : p_Window(NULL),
+                                              p_Surface(NULL),
+                                              p_Renderer(NULL),
+                                              p_Frame(NULL),
+                                              b_FrameValid(false),
+                                              p_Snapshot(NULL),
+                                              i_W(-1), // Keep -1 for UpdateSize()
+                                              i_H(-1),
+                                              i_SolarRate(i_SolarRate),
+                                              s_FrameDirectory(s_FrameDirectory),
+                                              u32_Frame(0),
+                                              s_SnapshotDirectory(s_SnapshotDirectory),
+                                              c_Profiler(v_PhaseName)
 {
     // Set Hints
     SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "1");
     
-    // Build the ui window first
-    p_Window = SDL_CreateWindow("MRange", 
-                                0, 0, 
-                                i_W, i_H, 
-                                SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
-    
-    if (p_Window == NULL)
+    if (b_Headless == true)
     {
-        throw Exception("Failed to create window!");
+        // Headless rendering uses a software renderer drawing to a surface, 
+        // the components stay the same
+        p_Surface = SDL_CreateRGBSurfaceWithFormat(0, 
+                                                   i_W, i_H, 
+                                                   32, 
+                                                   SDL_PIXELFORMAT_ARGB8888);
+        
+        if (p_Surface == NULL)
+        {
+            throw Exception("Failed to create headless surface!");
+        }
+        
+        p_Renderer = SDL_CreateSoftwareRenderer(p_Surface);
+        
+        if (p_Renderer == NULL)
+        {
+            SDL_FreeSurface(p_Surface);
+            throw Exception("Failed to create software renderer!");
+        }
     }
-    
-    // Next create a renderer for this window
-    p_Renderer = SDL_CreateRenderer(p_Window, 
-                                    0, 
-                                    SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC | SDL_RENDERER_TARGETTEXTURE);
-    
-    if (p_Renderer == NULL)
+    else
     {
-        SDL_DestroyWindow(p_Window);
-        throw Exception("Failed to create renderer!");
+        // Build the ui window first
+        p_Window = SDL_CreateWindow("MRange", 
+                                    0, 0, 
+                                    i_W, i_H, 
+                                    SDL_WINDOW_SHOWN | SDL_WINDOW_RESIZABLE);
+        
+        if (p_Window == NULL)
+        {
+            throw Exception("Failed to create window!");
+        }
+        
+        // Next create a renderer for this window
+        Uint32 u32_Flags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_TARGETTEXTURE;
+        
+        if (b_VSync == true)
+        {
+            u32_Flags |= SDL_RENDERER_PRESENTVSYNC;
+        }
+        
+        SDL_SetHint(SDL_HINT_RENDER_VSYNC, b_VSync == true ? "1" : "0");
+        
+        p_Renderer = SDL_CreateRenderer(p_Window, 
+                                        0, 
+                                        u32_Flags);
+        
+        if (p_Renderer == NULL)
+        {
+            SDL_DestroyWindow(p_Window);
+            throw Exception("Failed to create renderer!");
+        }
     }
     
-    // Now we update the UI with the size
-    UpdateSize(i_W, i_H);
+    // Show the last session while the rest of the startup runs
+    CreateSnapshotDirectory();
+    PresentSnapshot(i_W, i_H);
 }
 
 UI::~UI() noexcept
@@ -79,12 +202,27 @@ UI::~UI() noexcept
         delete Component;
     }
     
-    if (p_Renderer == NULL)
+    if (p_Frame != NULL)
+    {
+        SDL_DestroyTexture(p_Frame);
+    }
+    
+    if (p_Snapshot != NULL)
+    {
+        SDL_DestroyTexture(p_Snapshot);
+    }
+    
+    if (p_Renderer != NULL)
     {
         SDL_DestroyRenderer(p_Renderer);
     }
     
-    if (p_Window == NULL)
+    if (p_Surface != NULL)
+    {
+        SDL_FreeSurface(p_Surface);
+    }
+    
+    if (p_Window != NULL)
     {
         SDL_DestroyWindow(p_Window);
     }
@@ -94,6 +232,25 @@ UI::~UI() noexcept
 // Update
 //*************************************************************************************
 
+void UI::Initialize() noexcept
+{
+    int i_W;
+    int i_H;
+    
+    if (p_Surface != NULL)
+    {
+        i_W = p_Surface->w;
+        i_H = p_Surface->h;
+    }
+    else
+    {
+        SDL_GetWindowSize(p_Window, &i_W, &i_H);
+    }
+    
+    // Now we update the UI with the size
+    UpdateSize(i_W, i_H);
+}
+
 void UI::UpdateSize(int i_W, int i_H) noexcept
 {
     // Same size?
@@ -105,6 +262,104 @@ void UI::UpdateSize(int i_W, int i_H) noexcept
     this->i_W = i_W;
     this->i_H = i_H;
     
+    // Headless surfaces only grow, smaller sizes use the top left area. 
+    // The renderer is bound to its surface and textures to the renderer, 
+    // so components are created again.
+    if (p_Surface != NULL && (p_Surface->w < i_W || p_Surface->h < i_H))
+    {
+        SDL_Surface* p_NewSurface = SDL_CreateRGBSurfaceWithFormat(0, 
+                                                                   i_W, i_H, 
+                                                                   32, 
+                                                                   SDL_PIXELFORMAT_ARGB8888);
+        SDL_Renderer* p_NewRenderer = NULL;
+        
+        if (p_NewSurface != NULL)
+        {
+            p_NewRenderer = SDL_CreateSoftwareRenderer(p_NewSurface);
+        }
+        
+        if (p_NewRenderer == NULL)
+        {
+            MRANGEUI_LOG_WARNING("Failed to grow headless surface, drawing clipped!");
+            
+            if (p_NewSurface != NULL)
+            {
+                SDL_FreeSurface(p_NewSurface);
+            }
+        }
+        else
+        {
+            for (auto& Component : l_Component)
+            {
+                delete Component;
+            }
+            
+            l_Component.clear();
+            
+            if (p_Snapshot != NULL)
+            {
+                SDL_DestroyTexture(p_Snapshot);
+                p_Snapshot = NULL;
+            }
+            
+            SDL_DestroyRenderer(p_Renderer);
+            SDL_FreeSurface(p_Surface);
+            
+            p_Renderer = p_NewRenderer;
+            p_Surface = p_NewSurface;
+        }
+    }
+    
+    // Reuse the composed frame if the new size fits, headless surfaces 
+    // keep their content and are composed directly
+    int i_FrameW = 0;
+    int i_FrameH = 0;
+    
+    if (p_Surface == NULL &&
+        (p_Frame == NULL || 
+         SDL_QueryTexture(p_Frame, NULL, NULL, &i_FrameW, &i_FrameH) < 0 ||
+         i_FrameW < i_W ||
+         i_FrameH < i_H))
+    {
+        if (p_Frame != NULL)
+        {
+            SDL_DestroyTexture(p_Frame);
+        }
+        
+        p_Frame = SDL_CreateTexture(p_Renderer, 
+                                    SDL_PIXELFORMAT_RGBA8888, 
+                                    SDL_TEXTUREACCESS_TARGET, 
+                                    i_W, i_H);
+        
+        if (p_Frame == NULL)
+        {
+            MRANGEUI_LOG_WARNING("Failed to create frame texture, drawing uncached!");
+        }
+    }
+    
+    b_FrameValid = false;
+    
+    // Move existing components, loaded assets are kept
+    if (l_Component.size() == COMPONENT_COUNT)
+    {
+        try
+        {
+            int i_Component = BACKGROUND;
+            
+            for (auto& Component : l_Component)
+            {
+                Component->SetPosition(p_Renderer, 
+                                       GetComponentPosition(i_Component++));
+            }
+            
+            return;
+        }
+        catch (std::exception& e)
+        {
+            MRANGEUI_LOG_WARNING("Failed to resize components: {}", e.what());
+        }
+    }
+    
     // Clear old UI elements
     for (auto& Component : l_Component)
     {
@@ -114,34 +369,34 @@ void UI::UpdateSize(int i_W, int i_H) noexcept
     l_Component.clear();
     
     // Now rebuild all components
-    SDL_Rect c_Position;
-    
     try
     {
-        // Background
-        c_Position.x = 0;
-        c_Position.y = 0;
-        c_Position.w = i_W;
-        c_Position.h = i_H;
-        
         l_Component.emplace_back(new Background(p_Renderer,
-                                                c_Position,
-                                                UI_ASSET_DIR));
-        // Today Info
-        c_Position.x = i_W / 4;
-        c_Position.y = i_H / 4;
-        c_Position.w = i_W / 2;
-        c_Position.h = i_H / 2;
-        
+                                                GetComponentPosition(BACKGROUND),
+                                                UI_ASSET_DIR,
+                                                i_SolarRate));
         l_Component.emplace_back(new TodayInfo(p_Renderer,
-                                               c_Position,
+                                               GetComponentPosition(TODAY_INFO),
+                                               c_FontCache,
                                                UI_FONT_PATH));
     }
     catch (std::exception& e)
     {
-        Logger::Singleton().Log(Logger::ERROR, "Failed to create components: " + 
-                                               std::string(e.what()), 
-                                "UI.cpp", __LINE__);
+        MRANGEUI_LOG_ERROR("Failed to create components: {}", e.what());
+    }
+}
+
+SDL_Rect UI::GetComponentPosition(int i_Component) const noexcept
+{
+    switch (i_Component)
+    {
+        case BACKGROUND:
+            return { 0, 0, i_W, i_H };
+        case TODAY_INFO:
+            return { i_W / 4, i_H / 4, i_W / 2, i_H / 2 };
+        
+        default:
+            return { 0, 0, 0, 0 };
     }
 }
 
@@ -149,42 +404,406 @@ void UI::UpdateSize(int i_W, int i_H) noexcept
 // Draw
 //*************************************************************************************
 
-void UI::Draw(Clock const& c_Clock) noexcept
+bool UI::Draw(Clock const& c_Clock) noexcept
 {
-    Logger& c_Logger = Logger::Singleton();
-    
-    SDL_SetRenderTarget(p_Renderer, NULL);
-    SDL_SetRenderDrawColor(p_Renderer, 0, 0, 0, 255);
-    SDL_RenderClear(p_Renderer);
-    
-    SDL_Texture* p_Texture;
+    SDL_Rect c_Changed = { 0, 0, 0, 0 };
+    bool b_Changed = false;
+    uint64_t u64_FrameStart = Profiler::GetTime();
+    uint64_t u64_Start;
+    size_t us_Phase = PHASE_UPDATE_BACKGROUND;
     
     for (auto& Component : l_Component)
     {
         // Update component first
         if (Component == NULL)
         {
-            c_Logger.Log(Logger::ERROR, "Invalid component!", 
-                         "UI.cpp", __LINE__);
+            MRANGEUI_LOG_ERROR("Invalid component!");
+            ++us_Phase;
             continue;
         }
         
-        Component->Update(p_Renderer, c_Clock);
+        u64_Start = Profiler::GetTime();
         
-        // Updated, draw component texture
-        if ((p_Texture = Component->GetTexture()) == NULL)
+        if (Component->Update(p_Renderer, c_Clock) == true)
         {
-            c_Logger.Log(Logger::ERROR, "Invalid component texture!", 
-                         "UI.cpp", __LINE__);
+            // Collect the changed area in frame pixels
+            SDL_Rect const& c_Position = Component->GetPosition();
+            SDL_Rect c_Rect = Component->GetChanged();
+            
+            c_Rect.x += c_Position.x;
+            c_Rect.y += c_Position.y;
+            
+            SDL_UnionRect(&c_Changed, &c_Rect, &c_Changed);
+            b_Changed = true;
         }
-        else if (SDL_RenderCopy(p_Renderer,
-                                p_Texture,
-                                NULL, &(Component->GetPosition())) < 0)
+        
+        c_Profiler.Record(us_Phase++, u64_Start);
+    }
+    
+    // The snapshot stays until every component can draw itself
+    if (p_Snapshot != NULL)
+    {
+        if (GetReady() == false)
         {
-            c_Logger.Log(Logger::ERROR, "Failed to draw component!", 
-                         "UI.cpp", __LINE__);
+            return false;
         }
+        
+        SDL_DestroyTexture(p_Snapshot);
+        p_Snapshot = NULL;
+    }
+    
+    // Nothing changed, keep the last frame
+    if (b_Changed == false && b_FrameValid == true)
+    {
+        return false;
+    }
+    
+    // Compose frame, directly to the backbuffer if no frame texture exists
+    u64_Start = Profiler::GetTime();
+    
+    SDL_SetRenderTarget(p_Renderer, p_Frame);
+    SDL_SetRenderDrawColor(p_Renderer, 0, 0, 0, 255);
+    
+    // A valid frame only needs the changed area, window backbuffers are 
+    // undefined after presenting but headless surfaces are kept
+    bool b_Clip = ((p_Frame != NULL || p_Surface != NULL) && b_FrameValid == true && b_Changed == true);
+    
+    if (b_Clip == true)
+    {
+        // Components fill with the blend mode they found, keep it
+        SDL_BlendMode e_BlendMode = SDL_BLENDMODE_NONE;
+        SDL_GetRenderDrawBlendMode(p_Renderer, &e_BlendMode);
+        
+        SDL_RenderSetClipRect(p_Renderer, &c_Changed);
+        SDL_SetRenderDrawBlendMode(p_Renderer, SDL_BLENDMODE_NONE);
+        SDL_RenderFillRect(p_Renderer, &c_Changed);
+        SDL_SetRenderDrawBlendMode(p_Renderer, e_BlendMode);
+    }
+    else
+    {
+        SDL_RenderClear(p_Renderer);
+    }
+    
+    for (auto& Component : l_Component)
+    {
+        if (Component != NULL)
+        {
+            Component->Draw(p_Renderer);
+        }
+    }
+    
+    if (b_Clip == true)
+    {
+        SDL_RenderSetClipRect(p_Renderer, NULL);
+    }
+    
+    c_Profiler.Record(PHASE_COMPOSE, u64_Start);
+    
+    if (p_Frame == NULL)
+    {
+        u64_Start = Profiler::GetTime();
+        SDL_RenderPresent(p_Renderer);
+        c_Profiler.Record(PHASE_PRESENT, u64_Start);
+        
+        b_FrameValid = (p_Surface != NULL);
+        WriteFrame();
+    }
+    else
+    {
+        b_FrameValid = true;
+        Present();
+    }
+    
+    c_Profiler.Record(PHASE_FRAME, u64_FrameStart);
+    return true;
+}
+
+void UI::Present() noexcept
+{
+    // Still loading, show the snapshot again
+    if (p_Snapshot != NULL)
+    {
+        SDL_SetRenderTarget(p_Renderer, NULL);
+        SDL_RenderCopy(p_Renderer, p_Snapshot, NULL, NULL);
+        SDL_RenderPresent(p_Renderer);
+        
+        return;
+    }
+    
+    // Without a cached frame we have to wait for the next draw
+    if ((p_Frame == NULL && p_Surface == NULL) || b_FrameValid == false)
+    {
+        return;
+    }
+    
+    uint64_t u64_Start = Profiler::GetTime();
+    
+    // Headless surfaces already hold the frame
+    if (p_Frame == NULL)
+    {
+        SDL_RenderPresent(p_Renderer);
+        c_Profiler.Record(PHASE_PRESENT, u64_Start);
+        
+        WriteFrame();
+        return;
+    }
+    
+    SDL_SetRenderTarget(p_Renderer, NULL);
+    SDL_SetRenderDrawColor(p_Renderer, 0, 0, 0, 255);
+    SDL_RenderClear(p_Renderer);
+    
+    SDL_Rect c_Source = { 0, 0, i_W, i_H };
+    
+    if (SDL_RenderCopy(p_Renderer, p_Frame, &c_Source, NULL) < 0)
+    {
+        MRANGEUI_LOG_ERROR("Failed to draw frame!");
     }
     
     SDL_RenderPresent(p_Renderer);
+    c_Profiler.Record(PHASE_PRESENT, u64_Start);
+    
+    WriteFrame();
+}
+
+//*************************************************************************************
+// Snapshot
+//*************************************************************************************
+
+void UI::CreateSnapshotDirectory() noexcept
+{
+    if (s_SnapshotDirectory.size() == 0)
+    {
+        return;
+    }
+    
+    // Create each missing parent, like mkdir -p
+    size_t us_Pos = 0;
+    
+    do
+    {
+        us_Pos = s_SnapshotDirectory.find('/', us_Pos + 1);
+        std::string s_Directory = s_SnapshotDirectory.substr(0, us_Pos);
+        
+        if (mkdir(s_Directory.c_str(), 0755) < 0 && errno != EEXIST)
+        {
+            MRANGEUI_LOG_WARNING("Failed to create snapshot directory {}: {}, snapshots disabled!", 
+                                 s_Directory, 
+                                 strerror(errno));
+            
+            s_SnapshotDirectory.clear();
+            return;
+        }
+    }
+    while (us_Pos != std::string::npos);
+}
+
+bool UI::PresentSnapshot(int i_W, int i_H) noexcept
+{
+    if (s_SnapshotDirectory.size() == 0)
+    {
+        return false;
+    }
+    
+    // Uncompressed, loading only copies the pixels
+    std::string s_FilePath = GetSnapshotPath(i_W, i_H);
+    SDL_Surface* p_Image = SDL_LoadBMP(s_FilePath.c_str());
+    
+    if (p_Image == NULL)
+    {
+        MRANGEUI_LOG_INFO("No snapshot: {}", s_FilePath);
+        return false;
+    }
+    
+    SDL_Texture* p_Texture = NULL;
+    
+    if (p_Image->w == i_W && p_Image->h == i_H)
+    {
+        p_Texture = SDL_CreateTextureFromSurface(p_Renderer, p_Image);
+    }
+    
+    SDL_FreeSurface(p_Image);
+    
+    if (p_Texture == NULL)
+    {
+        MRANGEUI_LOG_WARNING("Failed to use snapshot: {}", s_FilePath);
+        return false;
+    }
+    
+    // Kept until the first real frame, exposed windows need it again
+    p_Snapshot = p_Texture;
+    Present();
+    
+    MRANGEUI_LOG_INFO("Presented snapshot: {}", s_FilePath);
+    
+    return true;
+}
+
+void UI::SaveSnapshot() noexcept
+{
+    // Only complete frames are kept
+    if (s_SnapshotDirectory.size() == 0 || (p_Frame == NULL && p_Surface == NULL) || b_FrameValid == false)
+    {
+        return;
+    }
+    
+    // Every write wears the flash, skip if the file on disk was written 
+    // for the same size and part of the day
+    std::string s_FilePath = GetSnapshotPath(i_W, i_H);
+    struct stat c_Stat;
+    
+    if (stat(s_FilePath.c_str(), &c_Stat) == 0 &&
+        c_Stat.st_size > 0 &&
+        GetSnapshotBucket(c_Stat.st_mtime) == GetSnapshotBucket(time(NULL)))
+    {
+        return;
+    }
+    
+    SDL_Surface* p_Image = SDL_CreateRGBSurfaceWithFormat(0, 
+                                                          i_W, i_H, 
+                                                          32, 
+                                                          SDL_PIXELFORMAT_ARGB8888);
+    
+    if (p_Image == NULL)
+    {
+        MRANGEUI_LOG_ERROR("Failed to create snapshot surface!");
+        return;
+    }
+    
+    SDL_Rect c_Rect = { 0, 0, i_W, i_H };
+    
+    SDL_SetRenderTarget(p_Renderer, p_Frame); // NULL for headless surfaces
+    int i_Result = SDL_RenderReadPixels(p_Renderer, 
+                                        &c_Rect, 
+                                        SDL_PIXELFORMAT_ARGB8888, 
+                                        p_Image->pixels, 
+                                        p_Image->pitch);
+    SDL_SetRenderTarget(p_Renderer, NULL);
+    
+    // Replace the old snapshot at once, the data has to be on disk before 
+    // the rename so that a power loss never leaves half a file
+    std::string s_TempPath = s_FilePath + ".tmp";
+    
+    if (i_Result < 0 || 
+        SDL_SaveBMP(p_Image, s_TempPath.c_str()) < 0 ||
+        SyncPath(s_TempPath.c_str(), O_RDONLY) == false ||
+        rename(s_TempPath.c_str(), s_FilePath.c_str()) < 0)
+    {
+        MRANGEUI_LOG_ERROR("Failed to save snapshot: {}", s_FilePath);
+        remove(s_TempPath.c_str());
+    }
+    else
+    {
+        // Keep the rename itself
+        SyncPath(s_SnapshotDirectory.c_str(), O_RDONLY | O_DIRECTORY);
+    }
+    
+    SDL_FreeSurface(p_Image);
+}
+
+std::string UI::GetSnapshotPath(int i_W, int i_H) const noexcept
+{
+    char p_File[48];
+    snprintf(p_File, sizeof(p_File), "/snapshot_%dx%d.bmp", i_W, i_H);
+    
+    return s_SnapshotDirectory + p_File;
+}
+
+//*************************************************************************************
+// Profiling
+//*************************************************************************************
+
+void UI::LogProfile() noexcept
+{
+    c_Profiler.LogSummary();
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+size_t UI::GetTextureBytes() const noexcept
+{
+    size_t us_Bytes = 0;
+    Uint32 u32_Format;
+    int i_FrameW;
+    int i_FrameH;
+    
+    if (p_Frame != NULL && SDL_QueryTexture(p_Frame, &u32_Format, NULL, &i_FrameW, &i_FrameH) == 0)
+    {
+        us_Bytes += (size_t)(SDL_BYTESPERPIXEL(u32_Format)) * i_FrameW * i_FrameH;
+    }
+    
+    for (auto& Component : l_Component)
+    {
+        if (Component != NULL)
+        {
+            us_Bytes += Component->GetTextureBytes();
+        }
+    }
+    
+    return us_Bytes;
+}
+
+bool UI::GetReady() const noexcept
+{
+    for (auto& Component : l_Component)
+    {
+        if (Component != NULL && Component->GetReady() == false)
+        {
+            return false;
+        }
+    }
+    
+    return true;
+}
+
+int UI::GetUpdateDelay() const noexcept
+{
+    int i_Delay = -1;
+    int i_Component;
+    
+    for (auto& Component : l_Component)
+    {
+        if (Component != NULL && 
+            (i_Component = Component->GetUpdateDelay()) >= 0 &&
+            (i_Delay < 0 || i_Component < i_Delay))
+        {
+            i_Delay = i_Component;
+        }
+    }
+    
+    return i_Delay;
+}
+
+//*************************************************************************************
+// Frames
+//*************************************************************************************
+
+void UI::WriteFrame() noexcept
+{
+    if (p_Surface == NULL || s_FrameDirectory.size() == 0)
+    {
+        return;
+    }
+    
+    char p_File[32];
+    snprintf(p_File, sizeof(p_File), "/frame_%06u.bmp", u32_Frame++);
+    
+    // The surface can be larger than the ui, write the used area only
+    SDL_Surface* p_Image = SDL_CreateRGBSurfaceWithFormatFrom(p_Surface->pixels, 
+                                                              std::min(i_W, p_Surface->w), 
+                                                              std::min(i_H, p_Surface->h), 
+                                                              32, 
+                                                              p_Surface->pitch, 
+                                                              p_Surface->format->format);
+    
+    if (p_Image == NULL || SDL_SaveBMP(p_Image, (s_FrameDirectory + p_File).c_str()) < 0)
+    {
+        MRANGEUI_LOG_ERROR("Failed to write frame: {}", SDL_GetError());
+    }
+    
+    if (p_Image != NULL)
+    {
+        SDL_FreeSurface(p_Image);
+    }
 }
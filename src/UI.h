@@ -19,11 +19,14 @@
 
 // C / C++
 #include <list>
+#include <string>
 
 // External
 
 // Project
 #include "./UIComponent/UIComponent.h"
+#include "./FontCache.h"
+#include "./Profiler.h"
 #include "./Clock.h"
 
 
@@ -40,10 +43,27 @@ public:
      *  
      *  \param i_W The user interface width.
      *  \param i_H The user interface height.  
+     *  \param b_Headless Render to a software surface instead of a window.
+     *  \param b_VSync Wait for the display refresh when presenting. Unused 
+     *                 for headless rendering.
+     *  \param i_SolarRate The solar body updates per second between minutes, 
+     *                     0 to move the solar body once per minute.
+     *  \param s_FrameDirectory The directory to write headless frames to, 
+     *                          empty to not write frames.
+     *  \param s_SnapshotDirectory The directory to keep frame snapshots in, 
+     *                             empty to not use snapshots. It is created 
+     *                             if missing. A snapshot for the size is 
+     *                             presented, components are created by 
+     *                             Initialize().
      */
     
     UI(int i_W,
-       int i_H);
+       int i_H,
+       bool b_Headless,
+       bool b_VSync,
+       int i_SolarRate,
+       std::string const& s_FrameDirectory,
+       std::string const& s_SnapshotDirectory);
     
     /**
      *  Default destructor.
@@ -56,7 +76,15 @@ public:
     //*************************************************************************************
     
     /**
-     *  Update the user interface size.
+     *  Create the components for the current size. SDL_image, SDL_ttf and 
+     *  the locale have to be ready.
+     */
+    
+    void Initialize() noexcept;
+    
+    /**
+     *  Update the user interface size. Existing components are moved and 
+     *  keep their loaded resources.
      *  
      *  \param i_W The user interface width.
      *  \param i_H The user interface height.
@@ -69,25 +97,158 @@ public:
     //*************************************************************************************
     
     /**
-     *  Update the user interface.
+     *  Update the user interface. The frame is only composed and presented 
+     *  if a component changed, only the changed area is composed again. 
+     *  A startup snapshot is kept instead until all components are ready.
      *  
      *  \param c_Clock The clock in use.
+     *  
+     *  \return true if a new frame was presented, false if not.
+     */
+    
+    bool Draw(Clock const& c_Clock) noexcept;
+    
+    /**
+     *  Present the last composed frame or the startup snapshot again.
+     */
+    
+    void Present() noexcept;
+    
+    //*************************************************************************************
+    // Snapshot
+    //*************************************************************************************
+    
+    /**
+     *  Save the last composed frame as the snapshot for the current size. 
+     *  Nothing is written if the snapshot on disk was saved in the same 
+     *  half hour of the day.
+     */
+    
+    void SaveSnapshot() noexcept;
+    
+    //*************************************************************************************
+    // Profiling
+    //*************************************************************************************
+    
+    /**
+     *  Log the update, compose and present times recorded since the last 
+     *  summary.
+     */
+    
+    void LogProfile() noexcept;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the memory used by the frame and all component textures.
+     *  
+     *  \return The texture memory in bytes.
+     */
+    
+    size_t GetTextureBytes() const noexcept;
+    
+    /**
+     *  Check if all components have everything they need to draw.
+     *  
+     *  \return true if all components are ready, false if not.
+     */
+    
+    bool GetReady() const noexcept;
+    
+    /**
+     *  Get the time until a component wants to update again without a 
+     *  minute change.
+     *  
+     *  \return The delay in milliseconds, -1 for no update.
      */
     
-    void Draw(Clock const& c_Clock) noexcept;
+    int GetUpdateDelay() const noexcept;
     
 private:
     
+    //*************************************************************************************
+    // Layout
+    //*************************************************************************************
+    
+    /**
+     *  Get the position of a component for the current size.
+     *  
+     *  \param i_Component The component to get the position for.
+     *  
+     *  \return The component position in pixels.
+     */
+    
+    SDL_Rect GetComponentPosition(int i_Component) const noexcept;
+    
+    //*************************************************************************************
+    // Frames
+    //*************************************************************************************
+    
+    /**
+     *  Write the headless surface to the frame directory.
+     */
+    
+    void WriteFrame() noexcept;
+    
+    //*************************************************************************************
+    // Snapshot
+    //*************************************************************************************
+    
+    /**
+     *  Create the snapshot directory and its parents. Snapshots are disabled 
+     *  if it can't be created.
+     */
+    
+    void CreateSnapshotDirectory() noexcept;
+    
+    /**
+     *  Present the snapshot for a size.
+     *  
+     *  \param i_W The snapshot width.
+     *  \param i_H The snapshot height.
+     *  
+     *  \return true if the snapshot was presented, false if not.
+     */
+    
+    bool PresentSnapshot(int i_W, int i_H) noexcept;
+    
+    /**
+     *  Get the snapshot file path for a size.
+     *  
+     *  \param i_W The snapshot width.
+     *  \param i_H The snapshot height.
+     *  
+     *  \return The snapshot file path.
+     */
+    
+    std::string GetSnapshotPath(int i_W, int i_H) const noexcept;
+    
     //*************************************************************************************
     // Data
     //*************************************************************************************
     
     SDL_Window* p_Window;
+    SDL_Surface* p_Surface; // Headless only
     SDL_Renderer* p_Renderer;
+    SDL_Texture* p_Frame; // Window only, backbuffers are undefined after presenting
+    bool b_FrameValid;
+    SDL_Texture* p_Snapshot; // Presented until all components are ready
     
     int i_W;
     int i_H;
     
+    int i_SolarRate;
+    
+    std::string s_FrameDirectory;
+    Uint32 u32_Frame;
+    
+    std::string s_SnapshotDirectory;
+    
+    Profiler c_Profiler;
+    
+    FontCache c_FontCache;
     std::list<UIComponent*> l_Component;
     
 protected:
@@ -15,13 +15,14 @@
  */
 
 // C / C++
-#include <math.h>
 
 // External
 #include <SDL2/SDL_image.h>
 
 // Project
 #include "./Background.h"
+#include "../Reactor.h"
+#include "../Profiler.h"
 #include "../Logger.h"
 
 // Pre-defined
@@ -49,66 +50,163 @@ namespace
         "Moon.png"
     };
     
-    enum Colors
+    // Pre-decoded assets, loose files are used if missing
+    const char* p_AssetPack = "Assets.pack";
+}
+
+
+//*************************************************************************************
+// Constructor / Destructor
+//*************************************************************************************
+
+Background::Background(SDL_Renderer* p_Renderer,
+                       SDL_Rect const& c_Position,
+                       std::string const& s_AssetDir,
+                       int i_SolarRate) : UIComponent(p_Renderer, 
+                                                      c_Position,
+                                                      false),
+                                      s_AssetDir(s_AssetDir),
+                                      p_Pack(NULL),
+                                      dq_Surface(ASSET_COUNT, NULL),
+                                      us_Loading(ASSET_COUNT),
+                                      u32_LastGeneration(0),
+                                      u64_SolarInterval(i_SolarRate > 0 ? 1000000000ULL / i_SolarRate : 0),
+                                      u64_LastSolar(0),
+                                      c_Entry(),
+                                      c_SolarRect({ 0, 0, 0, 0 }),
+                                      c_Changed({ 0, 0, c_Position.w, c_Position.h })
+{
+    // Use the asset pack if it holds everything, nothing to decode
+    try
     {
-        NIGHT = 0,
-        MORNING = 1,
-        DAY = 2,
-        EVENING = 3,
+        p_Pack = new AssetPack(s_AssetDir + "/" + p_AssetPack);
+        
+        for (size_t i = 0; i < ASSET_COUNT; ++i)
+        {
+            if (p_Pack->GetEntry(p_Asset[i]) == NULL)
+            {
+                throw Exception("Asset pack is missing file: " + std::string(p_Asset[i]));
+            }
+        }
         
-        COLORS_MAX = EVENING,
+        us_Loading = 0;
+        Reactor::Wake(Reactor::REDRAW, 0);
         
-        COLORS_COUNT = COLORS_MAX + 1
-    };
-    
-    Uint8 p_Colors[COLORS_COUNT][3] =
+        return;
+    }
+    catch (std::exception& e)
     {
-        { 0, 43, 72 },
-        { 247, 186, 0 },
-        { 0, 161, 254 },
-        { 238, 94, 73 },
-    };
+        MRANGEUI_LOG_INFO("{} Decoding asset files.", e.what());
+        
+        if (p_Pack != NULL)
+        {
+            delete p_Pack;
+            p_Pack = NULL;
+        }
+    }
     
-    constexpr Uint8 u8_MorningBegin = 6;
-    constexpr Uint8 u8_MorningEnd = 7;
-    constexpr Uint8 u8_DayBegin = 7;
-    constexpr Uint8 u8_DayEnd = 19;
-    constexpr Uint8 u8_EveningBegin = 19;
-    constexpr Uint8 u8_EveningEnd = 20;
-    constexpr Uint8 u8_NightBegin = 20;
-    constexpr Uint8 u8_NightEnd = 6;
+    StartLoaders();
 }
 
+Background::~Background() noexcept
+{
+    for (auto& Loader : v_Loader)
+    {
+        Loader.join();
+    }
+    
+    for (auto& Surface : dq_Surface)
+    {
+        if (Surface != NULL)
+        {
+            SDL_FreeSurface(Surface);
+        }
+    }
+    
+    for (auto& Asset : dq_Asset)
+    {
+        SDL_DestroyTexture(Asset);
+    }
+    
+    if (p_Pack != NULL)
+    {
+        delete p_Pack;
+    }
+}
 
 //*************************************************************************************
-// Constructor / Destructor
+// Assets
 //*************************************************************************************
 
-Background::Background(SDL_Renderer* p_Renderer,
-                       SDL_Rect const& c_Position,
-                       std::string const& s_AssetDir) : UIComponent(p_Renderer, 
-                                                                    c_Position),
-                                                        i_LastMinute(-1)
+void Background::StartLoaders() noexcept
 {
+    us_Loading = ASSET_COUNT;
+    
+    // Decode all assets in parallel, the textures are created on update
     for (size_t i = 0; i < ASSET_COUNT; ++i)
     {
         std::string s_FilePath = s_AssetDir +
                                  "/" +
                                  p_Asset[i];
         
-        SDL_Surface* p_Surface = IMG_Load(s_FilePath.c_str());
-        
-        if (p_Surface == NULL)
+        try
         {
-            throw Exception("Failed to load file: " + s_FilePath + "!");
+            v_Loader.emplace_back(&Background::Load, this, i, s_FilePath);
         }
+        catch (...)
+        {
+            Load(i, s_FilePath);
+        }
+    }
+}
+
+void Background::Load(size_t us_Asset, std::string s_FilePath) noexcept
+{
+    dq_Surface[us_Asset] = IMG_Load(s_FilePath.c_str());
+    
+    if (dq_Surface[us_Asset] == NULL)
+    {
+        MRANGEUI_LOG_ERROR("Failed to load file: {}!", s_FilePath);
+    }
+    
+    // Last one done, wake the main loop for the upload
+    if (--us_Loading == 0)
+    {
+        Reactor::Wake(Reactor::REDRAW, 0);
+    }
+}
+
+void Background::CreateTextures(SDL_Renderer* p_Renderer) noexcept
+{
+    for (auto& Loader : v_Loader)
+    {
+        Loader.join();
+    }
+    
+    v_Loader.clear();
+    
+    bool b_Pack = (p_Pack != NULL);
+    
+    // Upload all decoded assets on the render thread
+    for (size_t i = 0; i < ASSET_COUNT; ++i)
+    {
+        SDL_Texture* p_Texture = NULL;
         
-        SDL_Texture* p_Texture = SDL_CreateTextureFromSurface(p_Renderer, p_Surface);
-        SDL_FreeSurface(p_Surface);
+        if (p_Pack != NULL)
+        {
+            p_Texture = CreatePackTexture(p_Renderer, p_Asset[i]);
+        }
+        else if (dq_Surface[i] != NULL)
+        {
+            p_Texture = SDL_CreateTextureFromSurface(p_Renderer, dq_Surface[i]);
+            SDL_FreeSurface(dq_Surface[i]);
+            dq_Surface[i] = NULL;
+        }
         
         if (p_Texture == NULL)
         {
-            throw Exception("Failed to create texture for file: " + s_FilePath + "!");
+            MRANGEUI_LOG_ERROR("Failed to create texture for file: {}!", p_Asset[i]);
+            continue;
         }
         
         try
@@ -118,94 +216,168 @@ Background::Background(SDL_Renderer* p_Renderer,
         catch (...)
         {
             SDL_DestroyTexture(p_Texture);
-            throw Exception("Failed to store texture!");
+        }
+    }
+    
+    // Uploaded, the mapping is no longer needed
+    if (p_Pack != NULL)
+    {
+        delete p_Pack;
+        p_Pack = NULL;
+    }
+    
+    // All or nothing, missing assets keep the solid tint
+    if (dq_Asset.size() != ASSET_COUNT)
+    {
+        for (auto& Asset : dq_Asset)
+        {
+            SDL_DestroyTexture(Asset);
+        }
+        
+        dq_Asset.clear();
+        
+        // The renderer might not take the pack format, the files still work
+        if (b_Pack == true)
+        {
+            MRANGEUI_LOG_WARNING("Failed to use asset pack, decoding asset files.");
+            StartLoaders();
         }
     }
 }
 
-Background::~Background() noexcept
+SDL_Texture* Background::CreatePackTexture(SDL_Renderer* p_Renderer, const char* p_Name) noexcept
 {
-    for (auto& Asset : dq_Asset)
+    AssetPack::Entry const* p_Entry = p_Pack->GetEntry(p_Name);
+    
+    if (p_Entry == NULL)
     {
-        SDL_DestroyTexture(Asset);
+        return NULL;
+    }
+    
+    // Pixels are already in the texture format, upload from the mapping
+    SDL_Texture* p_Texture = SDL_CreateTexture(p_Renderer, 
+                                               p_Pack->GetFormat(), 
+                                               SDL_TEXTUREACCESS_STATIC, 
+                                               (int)(p_Entry->u32_W), 
+                                               (int)(p_Entry->u32_H));
+    
+    if (p_Texture == NULL)
+    {
+        return NULL;
     }
+    else if (SDL_UpdateTexture(p_Texture, NULL, p_Pack->GetPixels(*p_Entry), (int)(p_Entry->u32_Pitch)) < 0)
+    {
+        SDL_DestroyTexture(p_Texture);
+        return NULL;
+    }
+    
+    SDL_SetTextureBlendMode(p_Texture, SDL_BLENDMODE_BLEND);
+    
+    return p_Texture;
 }
 
 //*************************************************************************************
 // Update
 //*************************************************************************************
 
-void Background::Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
+bool Background::Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
 {
-    Logger& c_Logger = Logger::Singleton();
+    // Create textures once all assets are decoded
+    if ((p_Pack != NULL || v_Loader.empty() == false) && us_Loading == 0)
+    {
+        CreateTextures(p_Renderer);
+        b_Redraw = true;
+    }
     
     // Check the current time first
-    if (i_LastMinute == c_Clock.GetMinutes())
+    if (b_Redraw == false && u32_LastGeneration == c_Clock.GetGeneration())
     {
-        return;
+        // Same local minute, only the solar body area can change
+        if (u64_SolarInterval == 0 || dq_Asset.size() != ASSET_COUNT)
+        {
+            return false;
+        }
+        
+        uint64_t u64_Now = Profiler::GetTime();
+        
+        if (u64_Now - u64_LastSolar < u64_SolarInterval)
+        {
+            return false;
+        }
+        
+        u64_LastSolar = u64_Now;
+        
+        SDL_Rect c_Rect = GetSolarRect(c_Clock);
+        
+        if (SDL_RectEquals(&c_Rect, &c_SolarRect) == SDL_TRUE)
+        {
+            return false;
+        }
+        
+        // Redraw where the solar body was and where it is now
+        SDL_UnionRect(&c_SolarRect, &c_Rect, &c_Changed);
+        c_SolarRect = c_Rect;
+        
+        return true;
     }
     else
     {
-        i_LastMinute = c_Clock.GetMinutes();
+        u32_LastGeneration = c_Clock.GetGeneration();
+        b_Redraw = false;
     }
     
-    // Set the color to use for drawing
-    SDL_Color c_Color = CalculateTintColor(c_Clock);
+    // Set the color and solar body to use for drawing, the layers 
+    // themselves stay untouched
+    c_Entry = c_DayCycle.GetEntry(c_Clock.GetHours(), c_Clock.GetMinutes());
     
-    // Prepare target
-    SDL_SetRenderTarget(p_Renderer, p_Target);
-    SDL_SetRenderDrawColor(p_Renderer, 0, 0, 0, 0);
-    SDL_RenderClear(p_Renderer);
+    u64_LastSolar = Profiler::GetTime();
+    c_Changed = { 0, 0, GetPosition().w, GetPosition().h };
     
-    // Define render positions
-    SDL_Rect c_Rect;
+    if (dq_Asset.size() == ASSET_COUNT)
+    {
+        c_SolarRect = GetSolarRect(c_Clock);
+    }
     
-    // Draw background first
-    c_Rect.x = 0;
-    c_Rect.y = 0;
-    c_Rect.w = GetPosition().w;
-    c_Rect.h = GetPosition().h;
+    return true;
+}
+
+//*************************************************************************************
+// Draw
+//*************************************************************************************
+
+void Background::Draw(SDL_Renderer* p_Renderer) noexcept
+{
+    SDL_Rect const& c_Position = GetPosition();
+    SDL_Color const& c_Color = c_Entry.c_Tint;
+    
+    // Assets not ready, only show the tint
+    if (dq_Asset.size() != ASSET_COUNT)
+    {
+        SDL_SetRenderDrawColor(p_Renderer, c_Color.r, c_Color.g, c_Color.b, 255);
+        SDL_RenderFillRect(p_Renderer, &c_Position);
+        
+        return;
+    }
     
+    // Sky first, tinted while drawing
     SDL_SetTextureColorMod(dq_Asset[BACKGROUND], c_Color.r, c_Color.g, c_Color.b);
     
-    if (SDL_RenderCopy(p_Renderer, dq_Asset[BACKGROUND], NULL, &c_Rect) < 0)
+    if (SDL_RenderCopy(p_Renderer, dq_Asset[BACKGROUND], NULL, &c_Position) < 0)
     {
-        c_Logger.Log(Logger::ERROR, "Failed to draw background texture!", 
-                     "Background.cpp", __LINE__);
+        MRANGEUI_LOG_ERROR("Failed to draw background texture!");
     }
     
     // Solar Body (covered by foreground)
-    SDL_Texture* p_SolarBody = NULL;
+    SDL_Texture* p_SolarBody = dq_Asset[c_Entry.e_SolarBody == DayCycle::SUN ? SUN : MOON];
+    SDL_Rect c_Rect = c_SolarRect;
     
-    if (c_Clock.GetHours() >= u8_MorningBegin && c_Clock.GetHours() <= u8_EveningEnd)
-    {
-        p_SolarBody = dq_Asset[SUN];
-    }
-    else if (c_Clock.GetHours() >= u8_NightBegin || c_Clock.GetHours() <= u8_NightEnd)
-    {
-        p_SolarBody = dq_Asset[MOON];
-    }
+    c_Rect.x += c_Position.x;
+    c_Rect.y += c_Position.y;
     
-    if (p_SolarBody != NULL)
+    if (SDL_RectEmpty(&c_Rect) == SDL_FALSE && 
+        SDL_RenderCopy(p_Renderer, p_SolarBody, NULL, &c_Rect) < 0)
     {
-        if (SDL_QueryTexture(p_SolarBody, NULL, NULL, &(c_Rect.w), &(c_Rect.h)) == 0)
-        {
-            SDL_Point c_Point = CalculateSolarBodyPosition(c_Clock);
-            
-            c_Rect.x = c_Point.x - (c_Rect.w / 2);
-            c_Rect.y = c_Point.y - (c_Rect.h / 2);
-            
-            if (SDL_RenderCopy(p_Renderer, p_SolarBody, NULL, &c_Rect) < 0)
-            {
-                c_Logger.Log(Logger::ERROR, "Failed to draw solar body texture!", 
-                             "Background.cpp", __LINE__);
-            }
-        }
-        else
-        {
-            c_Logger.Log(Logger::ERROR, "Failed to query solar body texture!", 
-                         "Background.cpp", __LINE__);
-        }
+        MRANGEUI_LOG_ERROR("Failed to draw solar body texture!");
     }
     
     // Foreground
@@ -214,11 +386,11 @@ void Background::Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
     if (SDL_QueryTexture(dq_Asset[FOREGROUND_LEFT], NULL, NULL, &(c_Rect.w), &(c_Rect.h)) == 0 &&
         SDL_QueryTexture(dq_Asset[FOREGROUND_RIGHT], NULL, NULL, &(c_RectB.w), &(c_RectB.h)) == 0)
     {
-        c_Rect.x = 0;
-        c_Rect.y = GetPosition().h - c_Rect.h;
+        c_Rect.x = c_Position.x;
+        c_Rect.y = c_Position.y + c_Position.h - c_Rect.h;
         
-        c_RectB.x = GetPosition().w - c_RectB.w;
-        c_RectB.y = GetPosition().h - c_RectB.h;
+        c_RectB.x = c_Position.x + c_Position.w - c_RectB.w;
+        c_RectB.y = c_Position.y + c_Position.h - c_RectB.h;
         
         SDL_SetTextureColorMod(dq_Asset[FOREGROUND_LEFT], c_Color.r, c_Color.g, c_Color.b);
         SDL_SetTextureColorMod(dq_Asset[FOREGROUND_RIGHT], c_Color.r, c_Color.g, c_Color.b);
@@ -226,144 +398,86 @@ void Background::Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
         if (SDL_RenderCopy(p_Renderer, dq_Asset[FOREGROUND_LEFT], NULL, &c_Rect) < 0 || 
             SDL_RenderCopy(p_Renderer, dq_Asset[FOREGROUND_RIGHT], NULL, &c_RectB) < 0)
         {
-            c_Logger.Log(Logger::ERROR, "Failed to draw foreground textures!", 
-                         "Background.cpp", __LINE__);
+            MRANGEUI_LOG_ERROR("Failed to draw foreground textures!");
         }
     }
     else
     {
-        c_Logger.Log(Logger::ERROR, "Failed to query foreground textures!", 
-                     "Background.cpp", __LINE__);
+        MRANGEUI_LOG_ERROR("Failed to query foreground textures!");
     }
-    
-    // Reset target
-    SDL_SetRenderTarget(p_Renderer, NULL);
-}
-
-//*************************************************************************************
-// Color
-//*************************************************************************************
-
-static inline Uint8 MixColor(Uint8 u8_CurrentColor, Uint8 u8_NextColor, float f32_Percent) noexcept
-{
-    return (u8_CurrentColor * (1 - f32_Percent)) + (u8_NextColor * f32_Percent);
 }
 
-SDL_Color Background::CalculateTintColor(Clock const& c_Clock)
+SDL_Rect Background::GetSolarRect(Clock const& c_Clock) const noexcept
 {
-    // Get percentage of mix
-    int i_Hour = c_Clock.GetHours();
-    float f32_Percent = (float)(c_Clock.GetMinutes()) / 60.f;
+    SDL_Texture* p_SolarBody = dq_Asset[c_Entry.e_SolarBody == DayCycle::SUN ? SUN : MOON];
+    SDL_Rect c_Rect = { 0, 0, 0, 0 };
     
-    // Decide on the two tint colors to use
-    if (i_Hour == u8_MorningBegin)
-    {
-        /**
-         *  Night -> Morning
-         */
-        
-        return { MixColor(p_Colors[NIGHT][0], p_Colors[MORNING][0], f32_Percent),
-                 MixColor(p_Colors[NIGHT][1], p_Colors[MORNING][1], f32_Percent),
-                 MixColor(p_Colors[NIGHT][2], p_Colors[MORNING][2], f32_Percent) };
-    }
-    else if (i_Hour == u8_DayBegin)
-    {
-        /**
-         *  Morning -> Day
-         */
-        
-        return { MixColor(p_Colors[MORNING][0], p_Colors[DAY][0], f32_Percent),
-                 MixColor(p_Colors[MORNING][1], p_Colors[DAY][1], f32_Percent),
-                 MixColor(p_Colors[MORNING][2], p_Colors[DAY][2], f32_Percent) };
-    }
-    else if (i_Hour == u8_EveningBegin)
-    {
-        /**
-         *  Day -> Evening
-         */
-        
-        return { MixColor(p_Colors[DAY][0], p_Colors[EVENING][0], f32_Percent),
-                 MixColor(p_Colors[DAY][1], p_Colors[EVENING][1], f32_Percent),
-                 MixColor(p_Colors[DAY][2], p_Colors[EVENING][2], f32_Percent) };
-    }
-    else if (i_Hour == u8_NightBegin)
+    if (SDL_QueryTexture(p_SolarBody, NULL, NULL, &(c_Rect.w), &(c_Rect.h)) < 0)
     {
-        /**
-         *  Evening -> Night
-         */
-        
-        return { MixColor(p_Colors[EVENING][0], p_Colors[NIGHT][0], f32_Percent),
-                 MixColor(p_Colors[EVENING][1], p_Colors[NIGHT][1], f32_Percent),
-                 MixColor(p_Colors[EVENING][2], p_Colors[NIGHT][2], f32_Percent) };
-    }
-    else if (i_Hour >= u8_NightBegin || i_Hour <= u8_NightEnd)
-    {
-        /**
-         *  Night
-         */
-        
-        return { p_Colors[NIGHT][0], 
-                 p_Colors[NIGHT][1], 
-                 p_Colors[NIGHT][2] };
-    }
-    else
-    {
-        /**
-         *  Day
-         */
-        
-        return { p_Colors[DAY][0], 
-                 p_Colors[DAY][1], 
-                 p_Colors[DAY][2] };
+        MRANGEUI_LOG_ERROR("Failed to query solar body texture!");
+        return { 0, 0, 0, 0 };
     }
+    
+    // Move between minutes only if requested
+    float f32_X;
+    float f32_Y;
+    
+    c_DayCycle.GetSolarPosition(c_Clock.GetHours(), 
+                                c_Clock.GetMinutes(), 
+                                u64_SolarInterval > 0 ? c_Clock.GetMinuteOffset() : 0.f,
+                                f32_X, 
+                                f32_Y);
+    
+    SDL_Point c_Point = { (int)(GetPosition().w * f32_X),
+                          GetPosition().h + (int)(GetPosition().w * f32_Y) };
+    
+    c_Rect.x = c_Point.x - (c_Rect.w / 2);
+    c_Rect.y = c_Point.y - (c_Rect.h / 2);
+    
+    return c_Rect;
 }
 
 //*************************************************************************************
-// Solar Body
+// Getters
 //*************************************************************************************
 
-SDL_Point Background::CalculateSolarBodyPosition(Clock const& c_Clock)
+size_t Background::GetTextureBytes() const noexcept
 {
-    // Get amount moved in minutes
-    int i_Hour = c_Clock.GetHours();
-    int i_Minutes = c_Clock.GetMinutes();
-    int i_HourInterval = 0;
+    size_t us_Bytes = UIComponent::GetTextureBytes();
     
-    if (i_Hour >= u8_MorningBegin && i_Hour <= u8_EveningEnd)
+    for (auto& Asset : dq_Asset)
     {
-        i_HourInterval = u8_EveningEnd - u8_MorningBegin;
-        i_Hour -= u8_MorningBegin;
+        us_Bytes += UIComponent::GetTextureBytes(Asset);
     }
-    else
+    
+    return us_Bytes;
+}
+
+SDL_Rect Background::GetChanged() const noexcept
+{
+    return c_Changed;
+}
+
+int Background::GetUpdateDelay() const noexcept
+{
+    if (u64_SolarInterval == 0 || dq_Asset.size() != ASSET_COUNT)
     {
-        i_HourInterval = (24 - u8_NightBegin) + u8_NightEnd;
-        
-        // Correct hours due to 23->0 change
-        if (i_Hour >= u8_NightBegin)
-        {
-            i_Hour -= u8_NightBegin;
-        }
-        else if (i_Hour <= u8_NightEnd)
-        {
-            i_Hour += 24 - u8_NightBegin;
-        }
+        return -1;
     }
     
-    int i_MinutesMoved = (i_Hour * 60) + i_Minutes;
-    
-    // We check the progress of total move time next
-    float f32_MovePercent = (float)i_MinutesMoved / ((float)i_HourInterval * 60.f);
-    
-    // Now we can check where the body is, based on a half circle
-    // @NOTE: sin and cos work on radians, not degrees!
-    double f64_Angle = (M_PI * f32_MovePercent) + ((90.f * M_PI) / 180.f);
-    
-    // Now return the points based on R of background W
-    int i_HalfW = GetPosition().w / 2;
+    uint64_t u64_Passed = Profiler::GetTime() - u64_LastSolar;
     
-    int i_X = i_HalfW - (int)(i_HalfW * sin(f64_Angle));
-    int i_Y = GetPosition().h + (int)(i_HalfW * cos(f64_Angle));
+    if (u64_Passed >= u64_SolarInterval)
+    {
+        return 0;
+    }
     
-    return { i_X,
-             i_Y };
+    // Round up, waking early only spins the loop
+    return (int)((u64_SolarInterval - u64_Passed + 999999ULL) / 1000000ULL);
+}
+
+bool Background::GetReady() const noexcept
+{
+    // Textures are created once nothing is left to decode or upload
+    return p_Pack == NULL && v_Loader.empty() == true && us_Loading == 0;
 }
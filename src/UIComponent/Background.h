@@ -19,11 +19,16 @@
 
 // C / C++
 #include <deque>
+#include <vector>
+#include <thread>
+#include <atomic>
 
 // External
 
 // Project
 #include "./UIComponent.h"
+#include "../DayCycle.h"
+#include "../AssetPack.h"
 
 
 class Background : public UIComponent
@@ -35,16 +40,21 @@ public:
     //*************************************************************************************
     
     /**
-     *  Default constructor.
+     *  Default constructor. Assets are read from the asset pack if one 
+     *  exists, otherwise decoded in the background. They are kept as 
+     *  separate layers.
      *  
      *  \param p_Renderer The renderer to use for construction.
      *  \param c_Position The component position in pixels.  
      *  \param s_AssetDir The directory to load assets from.
+     *  \param i_SolarRate The solar body updates per second between minutes, 
+     *                     0 to move the solar body once per minute.
      */
     
     Background(SDL_Renderer* p_Renderer,
                SDL_Rect const& c_Position,
-               std::string const& s_AssetDir);
+               std::string const& s_AssetDir,
+               int i_SolarRate);
     
     /**
      *  Default destructor.
@@ -61,39 +71,116 @@ public:
      *  
      *  \param p_Renderer The renderer to use for updating.
      *  \param c_Clock The clock in use.  
+     *  
+     *  \return true if the component content changed, false if not.
      */
     
-    void Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept override;
+    bool Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept override;
+    
+    //*************************************************************************************
+    // Draw
+    //*************************************************************************************
+    
+    /**
+     *  Draw the background layers to the current render target. The tint 
+     *  is applied while drawing.
+     *  
+     *  \param p_Renderer The renderer to draw with.
+     */
+    
+    void Draw(SDL_Renderer* p_Renderer) noexcept override;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the memory used by all textures of this component.
+     *  
+     *  \return The texture memory in bytes.
+     */
+    
+    size_t GetTextureBytes() const noexcept override;
+    
+    /**
+     *  Get the area changed by the last update.
+     *  
+     *  \return The changed area in component pixels.
+     */
+    
+    SDL_Rect GetChanged() const noexcept override;
+    
+    /**
+     *  Get the time until the solar body moves again.
+     *  
+     *  \return The delay in milliseconds, -1 if the solar body only moves 
+     *          with the minute.
+     */
+    
+    int GetUpdateDelay() const noexcept override;
+    
+    /**
+     *  Check if the assets are uploaded or failed to load.
+     *  
+     *  \return true if the assets are done loading, false if not.
+     */
+    
+    bool GetReady() const noexcept override;
     
 private:
     
     //*************************************************************************************
-    // Color
+    // Assets
     //*************************************************************************************
     
     /**
-     *  Get the tint color for assets.
+     *  Decode all asset files in parallel.
+     */
+    
+    void StartLoaders() noexcept;
+    
+    /**
+     *  Decode an asset file.
+     *  
+     *  \param us_Asset The asset to decode.
+     *  \param s_FilePath The asset file path.
+     */
+    
+    void Load(size_t us_Asset, std::string s_FilePath) noexcept;
+    
+    /**
+     *  Create the asset textures from the asset pack or the decoded assets. 
+     *  The asset files are decoded instead if the asset pack fails.
+     *  
+     *  \param p_Renderer The renderer to create the textures with.
+     */
+    
+    void CreateTextures(SDL_Renderer* p_Renderer) noexcept;
+    
+    /**
+     *  Create an asset texture from the asset pack.
      *  
-     *  \param c_Clock The clock to use for time tinting.    
+     *  \param p_Renderer The renderer to create the texture with.
+     *  \param p_Name The asset file name.
      *  
-     *  \return The tint color.
+     *  \return The asset texture, NULL on failure.
      */
     
-    SDL_Color CalculateTintColor(Clock const& c_Clock);
+    SDL_Texture* CreatePackTexture(SDL_Renderer* p_Renderer, const char* p_Name) noexcept;
     
     //*************************************************************************************
-    // Solar Body
+    // Layout
     //*************************************************************************************
     
     /**
-     *  Calculate the position of the solar body.
+     *  Get the solar body area for the current time.
      *  
-     *  \param c_Clock The clock to use for position calculations.    
+     *  \param c_Clock The clock in use.
      *  
-     *  \return The point on which the body should be drawn.
+     *  \return The solar body area in component pixels.
      */
     
-    SDL_Point CalculateSolarBodyPosition(Clock const& c_Clock);
+    SDL_Rect GetSolarRect(Clock const& c_Clock) const noexcept;
     
     //*************************************************************************************
     // Data
@@ -101,7 +188,21 @@ private:
     
     std::deque<SDL_Texture*> dq_Asset;
     
-    int i_LastMinute;
+    std::string s_AssetDir;
+    AssetPack* p_Pack;
+    std::vector<std::thread> v_Loader;
+    std::deque<SDL_Surface*> dq_Surface;
+    std::atomic<size_t> us_Loading;
+    
+    DayCycle c_DayCycle;
+    
+    uint32_t u32_LastGeneration; // Clock generation drawn
+    
+    uint64_t u64_SolarInterval; // Nanoseconds, 0 for minute updates
+    uint64_t u64_LastSolar;
+    DayCycle::Entry c_Entry;
+    SDL_Rect c_SolarRect;
+    SDL_Rect c_Changed;
     
 protected:
     
@@ -24,6 +24,23 @@
 #include "./TodayInfo.h"
 #include "../Logger.h"
 
+// Pre-defined
+namespace
+{
+    // String buffers
+    constexpr size_t us_TimeLength = 64;
+    constexpr size_t us_DateLength = 128;
+    
+    constexpr int i_TimeSize = 156;
+    constexpr int i_DateSize = 48;
+    
+    // Failed updates are tried again after this delay
+    constexpr int i_RetryDelayMS = 1000;
+    
+    // Strings the atlases could not draw
+    size_t us_FallbackCount = 0;
+}
+
 
 //*************************************************************************************
 // Constructor / Destructor
@@ -31,136 +48,295 @@
 
 TodayInfo::TodayInfo(SDL_Renderer* p_Renderer,
                      SDL_Rect const& c_Position,
+                     FontCache& c_FontCache,
                      std::string const& s_FontFilePath) : UIComponent(p_Renderer, 
-                                                                      c_Position),
+                                                                      c_Position,
+                                                                      true),
+                                                          c_FontCache(c_FontCache),
                                                           s_FontFilePath(s_FontFilePath),
-                                                          i_LastMinute(-1)
+                                                          p_TimeAtlas(NULL),
+                                                          p_DateAtlas(NULL),
+                                                          p_TimeTexture(NULL),
+                                                          p_DateTexture(NULL),
+                                                          u32_LastGeneration(0),
+                                                          u32_FormatGeneration(0)
 {}
 
 TodayInfo::~TodayInfo() noexcept
-{}
+{
+    if (p_TimeAtlas != NULL)
+    {
+        delete p_TimeAtlas;
+    }
+    
+    if (p_DateAtlas != NULL)
+    {
+        delete p_DateAtlas;
+    }
+    
+    for (SDL_Texture* p_Texture : { p_TimeTexture, p_DateTexture })
+    {
+        if (p_Texture != NULL)
+        {
+            SDL_DestroyTexture(p_Texture);
+        }
+    }
+}
 
 //*************************************************************************************
 // Update
 //*************************************************************************************
 
-void TodayInfo::Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
+bool TodayInfo::Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
 {
-    // Check the current time first
-    if (i_LastMinute == c_Clock.GetMinutes())
+    // Rasterize the glyphs the locale formats can produce once, strings 
+    // are composed from these
+    TimeFormat const& c_Format = c_Clock.GetFormat();
+    
+    if (u32_FormatGeneration != c_Format.GetGeneration())
     {
-        // No need to redraw
-        return;
+        UpdateGlyphAtlas(p_Renderer, p_TimeAtlas, i_TimeSize, c_Format.GetCharacters(TimeFormat::TIME));
+        UpdateGlyphAtlas(p_Renderer, p_DateAtlas, i_DateSize, c_Format.GetCharacters(TimeFormat::DATE));
+        
+        u32_FormatGeneration = c_Format.GetGeneration();
+        b_Redraw = true;
     }
-    else
+    
+    // Check the current time first, local time changes are minutes 
+    // and time zones
+    if (b_Redraw == false && u32_LastGeneration == c_Clock.GetGeneration())
     {
-        // We check minute changes for updates
-        i_LastMinute = c_Clock.GetMinutes();
+        // No need to redraw
+        return false;
     }
     
-    // Build
+    // Build, strings the atlas can't draw are rasterized into the reused 
+    // streaming textures
+    char p_TimeString[us_TimeLength];
+    char p_DateString[us_DateLength];
     SDL_Texture* p_Time = NULL;
     SDL_Texture* p_Date = NULL;
+    SDL_Rect c_TimeRect;
+    SDL_Rect c_DateRect;
+    
+    c_Clock.GetTimeString(p_TimeString, sizeof(p_TimeString));
+    c_Clock.GetDateString(p_DateString, sizeof(p_DateString));
     
     try
     {
-        p_Time = CreateStringTexture(p_Renderer, 
-                                     c_Clock.GetTimeString(),
-                                     156);
-        p_Date = CreateStringTexture(p_Renderer, 
-                                     c_Clock.GetDateString(),
-                                     48);
+        p_Time = PrepareString(p_Renderer, 
+                               p_TimeAtlas,
+                               p_TimeTexture,
+                               p_TimeString,
+                               i_TimeSize,
+                               c_TimeRect);
+        p_Date = PrepareString(p_Renderer, 
+                               p_DateAtlas,
+                               p_DateTexture,
+                               p_DateString,
+                               i_DateSize,
+                               c_DateRect);
     }
     catch (Exception& e)
     {
-        if (p_Time != NULL)
-        {
-            SDL_DestroyTexture(p_Time);
-        }
-        
-        Logger::Singleton().Log(Logger::ERROR, e.what(), 
-                                "Date.cpp", __LINE__);
-        return;
+        // Keep the redraw, GetUpdateDelay() schedules the retry
+        MRANGEUI_LOG_ERROR("{}", e.what());
+        b_Redraw = true;
+        return false;
     }
     
+    u32_LastGeneration = c_Clock.GetGeneration();
+    b_Redraw = false;
+    
     // Prepare target
     SDL_SetRenderTarget(p_Renderer, p_Target);
     SDL_SetRenderDrawColor(p_Renderer, 0, 0, 0, 0);
     SDL_RenderClear(p_Renderer);
     
-    // Define render positions and draw
-    SDL_Rect c_TimeRect;
-    SDL_Rect c_DateRect;
+    // Define render positions and draw, textures only hold the string 
+    // at the top left
+    SDL_Rect const& c_Position = GetPosition();
+    SDL_Rect c_TimeSource = { 0, 0, c_TimeRect.w, c_TimeRect.h };
+    SDL_Rect c_DateSource = { 0, 0, c_DateRect.w, c_DateRect.h };
     
-    if (SDL_QueryTexture(p_Time, NULL, NULL, &(c_TimeRect.w), &(c_TimeRect.h)) < 0 ||
-        SDL_QueryTexture(p_Date, NULL, NULL, &(c_DateRect.w), &(c_DateRect.h)) < 0)
+    c_TimeRect.w = (c_Position.w < c_TimeRect.w ? c_Position.w : c_TimeRect.w);
+    c_TimeRect.h = ((c_Position.h / 2) < c_TimeRect.h ? (c_Position.h / 2) : c_TimeRect.h);
+    c_DateRect.w = (c_Position.w < c_DateRect.w ? c_Position.w : c_DateRect.w);
+    c_DateRect.h = ((c_Position.h / 2) < c_DateRect.h ? (c_Position.h / 2) : c_DateRect.h);
+    
+    c_TimeRect.x = (c_Position.w / 2) - (c_TimeRect.w / 2);
+    c_TimeRect.y = (c_Position.h / 2) - ((c_TimeRect.h + c_DateRect.h) / 2);
+    c_DateRect.x = (c_Position.w / 2) - (c_DateRect.w / 2);
+    c_DateRect.y = (c_TimeRect.y + c_TimeRect.h);
+    
+    if (DrawString(p_Renderer, p_TimeAtlas, p_Time, c_TimeSource, p_TimeString, c_TimeRect) == false || 
+        DrawString(p_Renderer, p_DateAtlas, p_Date, c_DateSource, p_DateString, c_DateRect) == false)
     {
-        Logger::Singleton().Log(Logger::ERROR, "Failed to querry textures!", 
-                                "Date.cpp", __LINE__);
-    }
-    else
-    {
-        SDL_Rect const& c_Position = GetPosition();
-        
-        c_TimeRect.w = (c_Position.w < c_TimeRect.w ? c_Position.w : c_TimeRect.w);
-        c_TimeRect.h = ((c_Position.h / 2) < c_TimeRect.h ? (c_Position.h / 2) : c_TimeRect.h);
-        c_DateRect.w = (c_Position.w < c_DateRect.w ? c_Position.w : c_DateRect.w);
-        c_DateRect.h = ((c_Position.h / 2) < c_DateRect.h ? (c_Position.h / 2) : c_DateRect.h);
-        
-        c_TimeRect.x = (c_Position.w / 2) - (c_TimeRect.w / 2);
-        c_TimeRect.y = (c_Position.h / 2) - ((c_TimeRect.h + c_DateRect.h) / 2);
-        c_DateRect.x = (c_Position.w / 2) - (c_DateRect.w / 2);
-        c_DateRect.y = (c_TimeRect.y + c_TimeRect.h);
-        
-        if (SDL_RenderCopy(p_Renderer, p_Time, NULL, &c_TimeRect) < 0 || 
-            SDL_RenderCopy(p_Renderer, p_Date, NULL, &c_DateRect) < 0)
-        {
-            Logger::Singleton().Log(Logger::ERROR, "Failed to draw textures!", 
-                                    "Date.cpp", __LINE__);
-        }
+        MRANGEUI_LOG_ERROR("Failed to draw textures!");
     }
     
     // Finish target
-    SDL_DestroyTexture(p_Time);
-    SDL_DestroyTexture(p_Date);
-    
     SDL_SetRenderTarget(p_Renderer, NULL);
+    
+    return true;
 }
 
 //*************************************************************************************
-// Textures
+// Strings
 //*************************************************************************************
 
-SDL_Texture* TodayInfo::CreateStringTexture(SDL_Renderer* p_Renderer, std::string const& s_String, int i_Size)
+SDL_Texture* TodayInfo::PrepareString(SDL_Renderer* p_Renderer, GlyphAtlas const* p_Atlas, SDL_Texture*& p_Texture, const char* p_String, int i_Size, SDL_Rect& c_Rect)
 {
-    // Get font first
-    TTF_Font* p_Font = NULL;
+    // Atlas strings need no texture
+    if (p_Atlas != NULL && p_Atlas->GetSize(p_String, c_Rect.w, c_Rect.h) == true)
+    {
+        return NULL;
+    }
     
-    if ((p_Font = TTF_OpenFont(s_FontFilePath.c_str(), i_Size)) == NULL)
+    ++us_FallbackCount;
+    UpdateStringTexture(p_Renderer, p_Texture, p_String, i_Size, c_Rect);
+    
+    return p_Texture;
+}
+
+bool TodayInfo::DrawString(SDL_Renderer* p_Renderer, GlyphAtlas const* p_Atlas, SDL_Texture* p_Texture, SDL_Rect const& c_Source, const char* p_String, SDL_Rect const& c_Rect) noexcept
+{
+    if (p_Texture != NULL)
+    {
+        return SDL_RenderCopy(p_Renderer, p_Texture, &c_Source, &c_Rect) == 0;
+    }
+    else if (p_Atlas != NULL)
     {
-        throw Exception("Failed to load font file: " + s_FontFilePath + "!");
+        return p_Atlas->Draw(p_Renderer, p_String, c_Rect);
     }
     
+    return false;
+}
+
+//*************************************************************************************
+// Textures
+//*************************************************************************************
+
+void TodayInfo::UpdateStringTexture(SDL_Renderer* p_Renderer, SDL_Texture*& p_Texture, const char* p_String, int i_Size, SDL_Rect& c_Rect)
+{
+    // Get font first
+    TTF_Font* p_Font = c_FontCache.GetFont(s_FontFilePath, i_Size);
+    
     // Now create a surface from the font
     SDL_Color c_Color = { 255, 255, 255 };
     SDL_Surface* p_Surface = TTF_RenderUTF8_Blended(p_Font, 
-                                                    s_String.c_str(), 
+                                                    p_String, 
                                                     c_Color);
-    TTF_CloseFont(p_Font);
     
     if (p_Surface == NULL)
     {
         throw Exception("Failed to render text!");
     }
     
-    SDL_Texture* p_Texture = SDL_CreateTextureFromSurface(p_Renderer, 
-                                                          p_Surface);
+    // Blended text should already match the texture format
+    if (p_Surface->format->format != SDL_PIXELFORMAT_ARGB8888)
+    {
+        SDL_Surface* p_Converted = SDL_ConvertSurfaceFormat(p_Surface, SDL_PIXELFORMAT_ARGB8888, 0);
+        SDL_FreeSurface(p_Surface);
+        
+        if ((p_Surface = p_Converted) == NULL)
+        {
+            throw Exception("Failed to convert text!");
+        }
+    }
+    
+    // Only grow the texture, steady updates reuse it
+    int i_TextureW = 0;
+    int i_TextureH = 0;
+    
+    if (p_Texture == NULL ||
+        SDL_QueryTexture(p_Texture, NULL, NULL, &i_TextureW, &i_TextureH) < 0 ||
+        i_TextureW < p_Surface->w ||
+        i_TextureH < p_Surface->h)
+    {
+        SDL_Texture* p_Created = SDL_CreateTexture(p_Renderer, 
+                                                   SDL_PIXELFORMAT_ARGB8888, 
+                                                   SDL_TEXTUREACCESS_STREAMING, 
+                                                   (i_TextureW < p_Surface->w ? p_Surface->w : i_TextureW), 
+                                                   (i_TextureH < p_Surface->h ? p_Surface->h : i_TextureH));
+        
+        if (p_Created == NULL)
+        {
+            SDL_FreeSurface(p_Surface);
+            throw Exception("Failed to create texture!");
+        }
+        
+        SDL_SetTextureBlendMode(p_Created, SDL_BLENDMODE_BLEND);
+        
+        if (p_Texture != NULL)
+        {
+            SDL_DestroyTexture(p_Texture);
+        }
+        
+        p_Texture = p_Created;
+    }
+    
+    c_Rect = { 0, 0, p_Surface->w, p_Surface->h };
+    
+    int i_Result = SDL_UpdateTexture(p_Texture, &c_Rect, p_Surface->pixels, p_Surface->pitch);
     SDL_FreeSurface(p_Surface);
     
-    if (p_Texture == NULL)
+    if (i_Result < 0)
+    {
+        throw Exception("Failed to update texture!");
+    }
+}
+
+void TodayInfo::UpdateGlyphAtlas(SDL_Renderer* p_Renderer, GlyphAtlas*& p_Atlas, int i_Size, const char* p_Characters) noexcept
+{
+    if (p_Atlas != NULL)
+    {
+        delete p_Atlas;
+        p_Atlas = NULL;
+    }
+    
+    try
+    {
+        p_Atlas = new GlyphAtlas(p_Renderer, 
+                                 c_FontCache.GetFont(s_FontFilePath, i_Size), 
+                                 p_Characters);
+    }
+    catch (Exception& e)
     {
-        throw Exception("Failed to create texture!");
+        MRANGEUI_LOG_WARNING("{} Rendering full strings.", e.what2());
     }
+}
+
+//*************************************************************************************
+// Getters
+//*************************************************************************************
+
+int TodayInfo::GetUpdateDelay() const noexcept
+{
+    return b_Redraw == true ? i_RetryDelayMS : -1;
+}
+
+size_t TodayInfo::GetFallbackCount() noexcept
+{
+    return us_FallbackCount;
+}
+
+size_t TodayInfo::GetTextureBytes() const noexcept
+{
+    size_t us_Bytes = UIComponent::GetTextureBytes();
     
-    return p_Texture;
+    for (GlyphAtlas const* p_Atlas : { p_TimeAtlas, p_DateAtlas })
+    {
+        if (p_Atlas != NULL)
+        {
+            us_Bytes += p_Atlas->GetTextureBytes();
+        }
+    }
+    
+    for (SDL_Texture* p_Texture : { p_TimeTexture, p_DateTexture })
+    {
+        us_Bytes += UIComponent::GetTextureBytes(p_Texture);
+    }
+    
+    return us_Bytes;
 }
@@ -23,6 +23,8 @@
 
 // Project
 #include "./UIComponent.h"
+#include "../GlyphAtlas.h"
+#include "../FontCache.h"
 
 
 class TodayInfo : public UIComponent
@@ -38,11 +40,13 @@ public:
      *  
      *  \param p_Renderer The renderer to use for construction.
      *  \param c_Position The component position in pixels.   
+     *  \param c_FontCache The font cache to load fonts from.
      *  \param s_FontFilePath The path to the font file to use.
      */
     
     TodayInfo(SDL_Renderer* p_Renderer,
               SDL_Rect const& c_Position,
+              FontCache& c_FontCache,
               std::string const& s_FontFilePath);
     
     /**
@@ -60,35 +64,122 @@ public:
      *  
      *  \param p_Renderer The renderer to use for updating.
      *  \param c_Clock The clock in use.  
+     *  
+     *  \return true if the component texture changed, false if not.
+     */
+    
+    bool Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept override;
+    
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the memory used by all textures of this component.
+     *  
+     *  \return The texture memory in bytes.
      */
     
-    void Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept override;
+    size_t GetTextureBytes() const noexcept override;
+    
+    /**
+     *  Get the time until a failed update is tried again.
+     *  
+     *  \return The delay in milliseconds, -1 if the last update succeeded.
+     */
+    
+    int GetUpdateDelay() const noexcept override;
+    
+    /**
+     *  Get the number of strings rasterized because the glyph atlas was 
+     *  missing characters. Counted for all instances on the render thread.
+     *  
+     *  \return The fallback string count.
+     */
+    
+    static size_t GetFallbackCount() noexcept;
     
 private:
     
+    //*************************************************************************************
+    // Strings
+    //*************************************************************************************
+    
+    /**
+     *  Prepare a string for drawing. The string texture is only updated if 
+     *  the atlas is missing glyphs for the string.
+     *  
+     *  \param p_Renderer The renderer to use for drawing.  
+     *  \param p_Atlas The glyph atlas for the font size or NULL.
+     *  \param p_Texture The reused string texture, created if needed.
+     *  \param p_String The string to draw.
+     *  \param i_Size The font size to use.
+     *  \param c_Rect The rect to store the string size in.
+     *  
+     *  \return A SDL_Texture for the given string or NULL if the atlas is used.
+     */
+    
+    SDL_Texture* PrepareString(SDL_Renderer* p_Renderer, GlyphAtlas const* p_Atlas, SDL_Texture*& p_Texture, const char* p_String, int i_Size, SDL_Rect& c_Rect);
+    
+    /**
+     *  Draw a prepared string.
+     *  
+     *  \param p_Renderer The renderer to use for drawing.  
+     *  \param p_Atlas The glyph atlas for the font size or NULL.
+     *  \param p_Texture The string texture or NULL if the atlas is used.
+     *  \param c_Source The string area in the string texture.
+     *  \param p_String The string to draw.
+     *  \param c_Rect The area to draw to.
+     *  
+     *  \return true if the string was drawn, false if not.
+     */
+    
+    bool DrawString(SDL_Renderer* p_Renderer, GlyphAtlas const* p_Atlas, SDL_Texture* p_Texture, SDL_Rect const& c_Source, const char* p_String, SDL_Rect const& c_Rect) noexcept;
+    
     //*************************************************************************************
     // Textures
     //*************************************************************************************
     
     /**
-     *  Create a texture for a string.
+     *  Rasterize a string into a streaming texture. The texture is only 
+     *  recreated if the string does not fit.
      *  
      *  \param p_Renderer The renderer to use for drawing.  
-     *  \param s_String The string to draw.
+     *  \param p_Texture The texture to update, created if needed.
+     *  \param p_String The string to draw.
      *  \param i_Size The font size to use.
+     *  \param c_Rect The rect to store the string area in.
+     */
+    
+    void UpdateStringTexture(SDL_Renderer* p_Renderer, SDL_Texture*& p_Texture, const char* p_String, int i_Size, SDL_Rect& c_Rect);
+    
+    /**
+     *  Create a glyph atlas again for a character set. The atlas is NULL 
+     *  if it could not be created.
      *  
-     *  \return A SDL_Texture for the given string.
+     *  \param p_Renderer The renderer to use for drawing.  
+     *  \param p_Atlas The glyph atlas to replace.
+     *  \param i_Size The font size to use.
+     *  \param p_Characters The characters to rasterize.
      */
     
-    SDL_Texture* CreateStringTexture(SDL_Renderer* p_Renderer, std::string const& s_String, int i_Size);
+    void UpdateGlyphAtlas(SDL_Renderer* p_Renderer, GlyphAtlas*& p_Atlas, int i_Size, const char* p_Characters) noexcept;
     
     //*************************************************************************************
     // Data
     //*************************************************************************************
     
+    FontCache& c_FontCache;
     std::string s_FontFilePath;
     
-    int i_LastMinute;
+    GlyphAtlas* p_TimeAtlas;
+    GlyphAtlas* p_DateAtlas;
+    
+    SDL_Texture* p_TimeTexture;
+    SDL_Texture* p_DateTexture;
+    
+    uint32_t u32_LastGeneration; // Clock generation drawn
+    uint32_t u32_FormatGeneration; // Time format generation of the atlases
     
 protected:
     
@@ -26,6 +26,7 @@
 // Project
 #include "../Clock.h"
 #include "../Exception.h"
+#include "../Logger.h"
 
 
 class UIComponent
@@ -41,34 +42,25 @@ public:
      *  
      *  \param p_Renderer The renderer to use for construction.
      *  \param c_Position The component position in pixels.
+     *  \param b_Cached true to draw to a cached target texture, false if the 
+     *                  component overrides Draw() to draw into the frame 
+     *                  directly.
      */
     
     UIComponent(SDL_Renderer* p_Renderer,
-                SDL_Rect const& c_Position) : p_Target(NULL)
+                SDL_Rect const& c_Position,
+                bool b_Cached) : p_Target(NULL),
+                                 b_Redraw(true),
+                                 b_Cached(b_Cached)
     {
-        this->c_Position.x = c_Position.x;
-        this->c_Position.y = c_Position.y;
-        this->c_Position.w = c_Position.w;
-        this->c_Position.h = c_Position.h;
-        
-        p_Target = SDL_CreateTexture(p_Renderer, 
-                                     SDL_PIXELFORMAT_RGBA8888, 
-                                     SDL_TEXTUREACCESS_TARGET, 
-                                     c_Position.w, c_Position.h);
-        
-        if (p_Target == NULL)
-        {
-            throw Exception("Failed to create ui component target texture!");
-        }
-        
-        SDL_SetTextureBlendMode(p_Target, SDL_BLENDMODE_BLEND);
+        SetPosition(p_Renderer, c_Position);
     }
     
     /**
      *  Default destructor.
      */
     
-    ~UIComponent() noexcept
+    virtual ~UIComponent() noexcept
     {
         if (p_Target != NULL)
         {
@@ -85,19 +77,102 @@ public:
      *  
      *  \param p_Renderer The renderer to use for updating.
      *  \param c_Clock The clock in use.
+     *  
+     *  \return true if the component content changed, false if not.
      */
     
-    virtual void Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
-    {}
+    virtual bool Update(SDL_Renderer* p_Renderer, Clock const& c_Clock) noexcept
+    {
+        return false;
+    }
+    
+    //*************************************************************************************
+    // Draw
+    //*************************************************************************************
+    
+    /**
+     *  Draw the UI component to the current render target at the component 
+     *  position.
+     *  
+     *  \param p_Renderer The renderer to draw with.
+     */
+    
+    virtual void Draw(SDL_Renderer* p_Renderer) noexcept
+    {
+        SDL_Rect c_Source = { 0, 0, c_Position.w, c_Position.h };
+        
+        if (p_Target == NULL)
+        {
+            MRANGEUI_LOG_ERROR("Invalid component texture!");
+        }
+        else if (SDL_RenderCopy(p_Renderer, p_Target, &c_Source, &c_Position) < 0)
+        {
+            MRANGEUI_LOG_ERROR("Failed to draw component!");
+        }
+    }
+    
+    //*************************************************************************************
+    // Setters
+    //*************************************************************************************
+    
+    /**
+     *  Set the component position. The target texture of cached components 
+     *  is reused if the new size fits and the component is redrawn on the 
+     *  next update.
+     *  
+     *  \param p_Renderer The renderer to use for the target texture.
+     *  \param c_Position The component position in pixels.
+     */
+    
+    void SetPosition(SDL_Renderer* p_Renderer, SDL_Rect const& c_Position)
+    {
+        int i_TargetW = 0;
+        int i_TargetH = 0;
+        
+        if (b_Cached == true && 
+            (p_Target == NULL || 
+             SDL_QueryTexture(p_Target, NULL, NULL, &i_TargetW, &i_TargetH) < 0 ||
+             i_TargetW < c_Position.w ||
+             i_TargetH < c_Position.h))
+        {
+            SDL_Texture* p_Texture = SDL_CreateTexture(p_Renderer, 
+                                                       SDL_PIXELFORMAT_RGBA8888, 
+                                                       SDL_TEXTUREACCESS_TARGET, 
+                                                       c_Position.w, c_Position.h);
+            
+            if (p_Texture == NULL)
+            {
+                throw Exception("Failed to create ui component target texture!");
+            }
+            
+            SDL_SetTextureBlendMode(p_Texture, SDL_BLENDMODE_BLEND);
+            
+            if (p_Target != NULL)
+            {
+                SDL_DestroyTexture(p_Target);
+            }
+            
+            p_Target = p_Texture;
+        }
+        
+        this->c_Position.x = c_Position.x;
+        this->c_Position.y = c_Position.y;
+        this->c_Position.w = c_Position.w;
+        this->c_Position.h = c_Position.h;
+        
+        b_Redraw = true;
+    }
     
     //*************************************************************************************
     // Getters
     //*************************************************************************************
     
     /**
-     *  Get the component texture.
+     *  Get the component texture. The texture can be larger than the 
+     *  component, the content is placed at the top left.
      *  
-     *  \return The component texture.
+     *  \return The component texture, NULL for components drawing 
+     *          directly.
      */
     
     SDL_Texture* GetTexture() noexcept
@@ -116,6 +191,51 @@ public:
         return c_Position;
     }
     
+    /**
+     *  Get the memory used by all textures of this component.
+     *  
+     *  \return The texture memory in bytes.
+     */
+    
+    virtual size_t GetTextureBytes() const noexcept
+    {
+        return GetTextureBytes(p_Target);
+    }
+    
+    /**
+     *  Get the area changed by the last update which returned true.
+     *  
+     *  \return The changed area in component pixels.
+     */
+    
+    virtual SDL_Rect GetChanged() const noexcept
+    {
+        return { 0, 0, c_Position.w, c_Position.h };
+    }
+    
+    /**
+     *  Get the time until the component wants to update again without a 
+     *  minute change.
+     *  
+     *  \return The delay in milliseconds, -1 for no update.
+     */
+    
+    virtual int GetUpdateDelay() const noexcept
+    {
+        return -1;
+    }
+    
+    /**
+     *  Check if the component has everything it needs to draw itself.
+     *  
+     *  \return true if the component is ready, false if it still loads.
+     */
+    
+    virtual bool GetReady() const noexcept
+    {
+        return true;
+    }
+    
 private:
     
     //*************************************************************************************
@@ -126,11 +246,39 @@ private:
     
 protected:
     
+    //*************************************************************************************
+    // Getters
+    //*************************************************************************************
+    
+    /**
+     *  Get the memory used by a texture.
+     *  
+     *  \param p_Texture The texture to check.
+     *  
+     *  \return The texture memory in bytes, 0 for no texture.
+     */
+    
+    static size_t GetTextureBytes(SDL_Texture* p_Texture) noexcept
+    {
+        Uint32 u32_Format;
+        int i_W;
+        int i_H;
+        
+        if (p_Texture == NULL || SDL_QueryTexture(p_Texture, &u32_Format, NULL, &i_W, &i_H) < 0)
+        {
+            return 0;
+        }
+        
+        return (size_t)(SDL_BYTESPERPIXEL(u32_Format)) * i_W * i_H;
+    }
+    
     //*************************************************************************************
     // Data
     //*************************************************************************************
     
-    SDL_Texture* p_Target;
+    SDL_Texture* p_Target; // Cached only
+    bool b_Redraw;
+    const bool b_Cached;
 };
 
 #endif /* UIComponent_h */